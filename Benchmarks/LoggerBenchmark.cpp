@@ -0,0 +1,209 @@
+// LoggerBenchmark.cpp
+// Per call latency and throughput of the Logger output policies.
+//
+// Usage: LoggerBenchmark [--threads=N] [--calls=N] [--policy=name]
+//
+// Runs every policy with 1, 2, 4 ... N threads (N defaults to the core count)
+// and writes one JSON object per run to stdout, eg
+// {"policy":"Console","threads":2,"calls":200000,"seconds":0.41,"callsPerSecond":487804,"p50Ns":310,"p99Ns":2100,"p999Ns":9800,"maxNs":51000}
+// Save the output from two builds and diff them to spot regressions.
+
+#include <Dead/Log/Logger.hpp>
+#include <Dead/Log/LoggerPolicies.hpp>
+#include <Dead/Log/RecordHeader.hpp>
+#include <Dead/Log/FlightRecorder.hpp>
+#include <Dead/Log/TeeOutput.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+struct RunResult
+{
+	std::string 	policy;
+	unsigned int 	threads;
+	std::size_t 	calls;
+	double 			seconds;
+	std::uint64_t 	p50Ns, p99Ns, p999Ns, maxNs;
+};
+
+
+// Throws everything away. It has no state to share, so every thread can
+// write through std::cout at once; a std::filebuf on /dev/null can't be
+// shared that way without a lock the loggers don't take.
+class NullBuffer : public std::streambuf
+{
+protected:
+
+	std::streamsize xsputn(char const *, std::streamsize count) {
+		return count;
+	}
+
+	int_type overflow(int_type c) {
+		return traits_type::not_eof(c);
+	}
+};
+
+
+// Each thread times its own calls with the tick clock.
+template<typename Policy>
+void logCalls(std::size_t calls, std::vector<std::uint64_t> & latencyNs)
+{
+	double const nsPerTick = Dead::TickClock::calibration().nsPerTick;
+	std::string const name("player");
+
+	latencyNs.resize(calls);
+
+	for(std::size_t i = 0; i < calls; ++i)
+	{
+		std::uint64_t const start = Dead::TickClock::now();
+
+		Dead::Logger<Policy>() << "Frame " << i << " " << name << " hp " << 0.75 * double(i) << ' ' << (i & 1);
+
+		latencyNs[i] = std::uint64_t(double(Dead::TickClock::now() - start) * nsPerTick);
+	}
+}
+
+
+std::uint64_t percentile(std::vector<std::uint64_t> const & sorted, double fraction)
+{
+	std::size_t index = std::size_t(fraction * double(sorted.size()));
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+
+template<typename Policy>
+RunResult run(char const * policy, unsigned int threadCount, std::size_t callsPerThread)
+{
+	std::vector<std::vector<std::uint64_t> > latencies(threadCount);
+	std::vector<std::thread> threads;
+
+	std::uint64_t const start = Dead::TickClock::now();
+
+	for(unsigned int i = 0; i < threadCount; ++i) {
+		threads.push_back(std::thread(logCalls<Policy>, callsPerThread, std::ref(latencies[i])));
+	}
+
+	for(unsigned int i = 0; i < threadCount; ++i) {
+		threads[i].join();
+	}
+
+	std::uint64_t const end = Dead::TickClock::now();
+
+	std::vector<std::uint64_t> all;
+	all.reserve(threadCount * callsPerThread);
+
+	for(unsigned int i = 0; i < threadCount; ++i) {
+		all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+	}
+
+	std::sort(all.begin(), all.end());
+
+	RunResult result;
+	result.policy 	= policy;
+	result.threads 	= threadCount;
+	result.calls 	= all.size();
+	result.seconds 	= double(end - start) * Dead::TickClock::calibration().nsPerTick * 1e-9;
+	result.p50Ns 	= percentile(all, 0.5);
+	result.p99Ns 	= percentile(all, 0.99);
+	result.p999Ns 	= percentile(all, 0.999);
+	result.maxNs 	= all.back();
+
+	return result;
+}
+
+
+void report(RunResult const & result)
+{
+	std::printf("{\"policy\":\"%s\",\"threads\":%u,\"calls\":%lu,\"seconds\":%.6f,\"callsPerSecond\":%.0f,"
+				"\"p50Ns\":%lu,\"p99Ns\":%lu,\"p999Ns\":%lu,\"maxNs\":%lu}\n",
+		result.policy.c_str(), result.threads, (unsigned long)result.calls, result.seconds,
+		double(result.calls) / result.seconds,
+		(unsigned long)result.p50Ns, (unsigned long)result.p99Ns,
+		(unsigned long)result.p999Ns, (unsigned long)result.maxNs);
+
+	std::fflush(stdout);
+}
+
+
+bool wanted(std::string const & only, char const * policy) {
+	return only.empty() || only == policy;
+}
+
+
+int main(int argc, char **argv)
+{
+	unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	std::size_t calls 		= 100000;
+	std::string only;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		if(std::strncmp(argv[i], "--threads=", 10) == 0) {
+			maxThreads = unsigned(std::max(1, std::atoi(argv[i] + 10)));
+		} else if(std::strncmp(argv[i], "--calls=", 8) == 0) {
+			calls = std::size_t(std::max(1, std::atoi(argv[i] + 8)));
+		} else if(std::strncmp(argv[i], "--policy=", 9) == 0) {
+			only = argv[i] + 9;
+		} else {
+			std::cerr << "Usage: " << argv[0] << " [--threads=N] [--calls=N] [--policy=Console|Stamped|File|FlightRecorder|Tee]" << std::endl;
+			return 1;
+		}
+	}
+
+	Dead::TickClock::calibrate();
+
+	// Console policies write to nothing, stdout is kept for the results.
+	NullBuffer discard;
+	std::streambuf *console = std::cout.rdbuf(&discard);
+
+	Dead::FlightRecorder::instance().open("LoggerBenchmark.rec");
+
+	// 1, 2, 4 ... and always maxThreads itself.
+	std::vector<unsigned int> threadCounts;
+
+	for(unsigned int threads = 1; threads < maxThreads; threads *= 2) {
+		threadCounts.push_back(threads);
+	}
+
+	threadCounts.push_back(maxThreads);
+
+	for(std::size_t i = 0; i < threadCounts.size(); ++i)
+	{
+		unsigned int const threads = threadCounts[i];
+
+		if(wanted(only, "Console")) {
+			report(run<Dead::ConsoleOutput>("Console", threads, calls));
+		}
+
+		if(wanted(only, "Stamped")) {
+			report(run<Dead::StampedOutput<Dead::ConsoleOutput> >("Stamped", threads, calls));
+		}
+
+		if(wanted(only, "File")) {
+			report(run<Dead::FileOutput>("File", threads, calls));
+		}
+
+		if(wanted(only, "FlightRecorder")) {
+			report(run<Dead::FlightRecorderOutput>("FlightRecorder", threads, calls));
+		}
+
+		if(wanted(only, "Tee")) {
+			report(run<Dead::TeeOutput<Dead::ConsoleOutput, Dead::FlightRecorderOutput> >("Tee", threads, calls));
+		}
+	}
+
+	Dead::FlightRecorder::instance().close();
+	std::remove("LoggerBenchmark.rec");
+	std::remove("LoggerOutput.txt");
+
+	std::cout.rdbuf(console);
+
+	return 0;
+}
@@ -0,0 +1,18 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ * 	About
+ *	Everything DeadCode knows about the build, see the files in Dead/Config/.
+ */
+
+
+#ifndef DEAD_CONFIG_INCLUDED
+#define DEAD_CONFIG_INCLUDED
+
+#include <Dead/Config/Platform.hpp>
+#include <Dead/Config/Compiler.hpp>
+#include <Dead/Config/Cpu.hpp>
+#include <Dead/Config/Threads.hpp>
+
+#endif // include guard
@@ -0,0 +1,84 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Which compiler and C++ standard we're building with, and some hints.
+ *
+ *	DEAD_COMPILER_MSVC, DEAD_COMPILER_CLANG or DEAD_COMPILER_GCC.
+ *	DEAD_CPP_VERSION is __cplusplus (MSVC only reports it properly through
+ *	_MSVC_LANG), DEAD_HAS_CPP11 / 14 / 17 / 20 follow from it.
+ *	DEAD_HAS_COROUTINES if <coroutine> can be used.
+ *	DEAD_FORCE_INLINE, DEAD_NOINLINE, DEAD_LIKELY(x) and DEAD_UNLIKELY(x).
+ */
+
+
+#ifndef DEAD_CONFIG_COMPILER_INCLUDED
+#define DEAD_CONFIG_COMPILER_INCLUDED
+
+
+// Clang defines __GNUC__ too, so check it first.
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define DEAD_COMPILER_MSVC
+#elif defined(__clang__)
+	#define DEAD_COMPILER_CLANG
+#elif defined(__GNUC__)
+	#define DEAD_COMPILER_GCC
+#endif
+
+
+#if defined(_MSVC_LANG)
+	#define DEAD_CPP_VERSION _MSVC_LANG
+#else
+	#define DEAD_CPP_VERSION __cplusplus
+#endif
+
+#if DEAD_CPP_VERSION >= 201103L
+	#define DEAD_HAS_CPP11
+#endif
+
+#if DEAD_CPP_VERSION >= 201402L
+	#define DEAD_HAS_CPP14
+#endif
+
+#if DEAD_CPP_VERSION >= 201703L
+	#define DEAD_HAS_CPP17
+#endif
+
+#if DEAD_CPP_VERSION >= 202002L
+	#define DEAD_HAS_CPP20
+#endif
+
+
+#if defined(DEAD_HAS_CPP20) && defined(__has_include)
+	#if __has_include(<coroutine>)
+		#define DEAD_HAS_COROUTINES
+	#endif
+#endif
+
+
+#if defined(DEAD_COMPILER_MSVC)
+	#define DEAD_FORCE_INLINE 	__forceinline
+	#define DEAD_NOINLINE 		__declspec(noinline)
+	#define DEAD_LIKELY(x) 		(x)
+	#define DEAD_UNLIKELY(x) 	(x)
+#elif defined(DEAD_COMPILER_GCC) || defined(DEAD_COMPILER_CLANG)
+	#define DEAD_FORCE_INLINE 	inline __attribute__((always_inline))
+	#define DEAD_NOINLINE 		__attribute__((noinline))
+	#define DEAD_LIKELY(x) 		__builtin_expect(!!(x), 1)
+	#define DEAD_UNLIKELY(x) 	__builtin_expect(!!(x), 0)
+#else
+	#define DEAD_FORCE_INLINE 	inline
+	#define DEAD_NOINLINE
+	#define DEAD_LIKELY(x) 		(x)
+	#define DEAD_UNLIKELY(x) 	(x)
+#endif
+
+
+#endif // #ifndef DEAD_CONFIG_COMPILER_INCLUDED
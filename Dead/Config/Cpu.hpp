@@ -0,0 +1,65 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	What the target CPU gives us.
+ *
+ *	Compile time (what the compiler was told it may use):
+ *	DEAD_ARCH_X86 / DEAD_ARCH_X64 / DEAD_ARCH_ARM / DEAD_ARCH_ARM64,
+ *	DEAD_HAS_SSE2, DEAD_HAS_AVX2, DEAD_HAS_NEON, DEAD_HAS_RDTSC,
+ *	DEAD_CACHE_LINE_SIZE.
+ */
+
+
+#ifndef DEAD_CONFIG_CPU_INCLUDED
+#define DEAD_CONFIG_CPU_INCLUDED
+
+#include <Dead/Config/Compiler.hpp>
+
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#define DEAD_ARCH_X64
+#elif defined(_M_IX86) || defined(__i386__)
+	#define DEAD_ARCH_X86
+#elif defined(_M_ARM64) || defined(__aarch64__)
+	#define DEAD_ARCH_ARM64
+#elif defined(_M_ARM) || defined(__arm__)
+	#define DEAD_ARCH_ARM
+#endif
+
+
+#if defined(DEAD_ARCH_X64) || defined(DEAD_ARCH_X86)
+	#define DEAD_HAS_RDTSC
+
+	#if defined(DEAD_ARCH_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define DEAD_HAS_SSE2
+	#endif
+
+	#if defined(__AVX2__)
+		#define DEAD_HAS_AVX2
+	#endif
+#endif
+
+#if defined(DEAD_ARCH_ARM64) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define DEAD_HAS_NEON
+#endif
+
+
+// Apple's arm64 cores use 128 byte lines.
+#if !defined(DEAD_CACHE_LINE_SIZE)
+	#if defined(__APPLE__) && defined(DEAD_ARCH_ARM64)
+		#define DEAD_CACHE_LINE_SIZE 128
+	#else
+		#define DEAD_CACHE_LINE_SIZE 64
+	#endif
+#endif
+
+
+#endif // #ifndef DEAD_CONFIG_CPU_INCLUDED
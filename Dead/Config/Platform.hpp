@@ -0,0 +1,40 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Which OS we're building for.
+ *	DEAD_ON_WINDOWS, DEAD_ON_LINUX, DEAD_ON_MAC and DEAD_ON_POSIX (Linux,
+ *	Mac and the BSDs).
+ *	Define DEAD_PLATFORM_CONFIGURED to set these by hand instead.
+ */
+
+
+#ifndef DEAD_CONFIG_PLATFORM_INCLUDED
+#define DEAD_CONFIG_PLATFORM_INCLUDED
+
+
+#if !defined(DEAD_PLATFORM_CONFIGURED)
+
+#if defined(_WIN32)
+	#define DEAD_ON_WINDOWS
+#elif defined(__linux__)
+	#define DEAD_ON_LINUX
+	#define DEAD_ON_POSIX
+#elif defined(__APPLE__) && defined(__MACH__)
+	#define DEAD_ON_MAC
+	#define DEAD_ON_POSIX
+#elif defined(__unix__)
+	#define DEAD_ON_POSIX
+#endif
+
+#endif // DEAD_PLATFORM_CONFIGURED
+
+
+#endif // #ifndef DEAD_CONFIG_PLATFORM_INCLUDED
@@ -0,0 +1,40 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Threading and atomics support.
+ *	DEAD_HAS_THREADS if std::thread can be used (not on single threaded
+ *	targets like Emscripten without pthreads).
+ *	DEAD_HAS_LOCK_FREE_32 / DEAD_HAS_LOCK_FREE_64 if std::atomic of that
+ *	width never takes a lock, the lock free paths need these.
+ */
+
+
+#ifndef DEAD_CONFIG_THREADS_INCLUDED
+#define DEAD_CONFIG_THREADS_INCLUDED
+
+#include <atomic>
+#include <Dead/Config/Compiler.hpp>
+
+
+#if !(defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__))
+	#define DEAD_HAS_THREADS
+#endif
+
+#if ATOMIC_INT_LOCK_FREE == 2
+	#define DEAD_HAS_LOCK_FREE_32
+#endif
+
+#if ATOMIC_LLONG_LOCK_FREE == 2
+	#define DEAD_HAS_LOCK_FREE_64
+#endif
+
+
+#endif // #ifndef DEAD_CONFIG_THREADS_INCLUDED
@@ -0,0 +1,214 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	A ring of fixed size slots in MAP_SHARED memory, a header followed by
+ *	slotCount slots. Shared by the FlightRecorder (a file) and the
+ *	SharedEventBus (shm_open), which each lay out their own header and slots.
+ *	It belongs to neither module, so it lives here rather than in their
+ *	Details directories.
+ *
+ *	Both need the Header to have a uint32 slotCount, and the Slot to start
+ *	with an atomic uint64 sequence. A slot's sequence is 0 while empty or
+ *	being written, otherwise the sequence number it was published with + 1.
+ *	Writers take sequence numbers off the header however they like and
+ *	publish() into the slot, readers check the sequence before and after
+ *	copying a slot out. POSIX only.
+ */
+
+
+#ifndef DEAD_DETAILS_MAPPED_RING_INCLUDED
+#define DEAD_DETAILS_MAPPED_RING_INCLUDED
+
+#include <Dead/Config/Platform.hpp>
+
+#if !defined(DEAD_ON_POSIX)
+#error MappedRing needs mmap, it is POSIX only.
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <Dead/Config/Threads.hpp>
+
+
+#if !defined(DEAD_HAS_LOCK_FREE_64)
+#error MappedRing needs lock free 64 bit atomics, the slot sequences live in the mapped memory.
+#endif
+
+
+namespace Dead {
+
+
+/*!
+ *	One mapping of a ring. HeaderSize is where the slots start, at least
+ *	sizeof(Header).
+ */
+template<typename Header, typename Slot, std::size_t HeaderSize = sizeof(Header)>
+class MappedRing
+{
+	static_assert(HeaderSize >= sizeof(Header), "MappedRing slots would overlap the header.");
+
+	Header 			*m_header;
+	Slot 			*m_slots;
+	std::size_t 	m_mappedSize;
+
+	//! Kept here so writers don't read it off the same line as the
+	//! contended header counter.
+	std::uint32_t 	m_slotCount;
+
+	bool map(int file, std::size_t size)
+	{
+		void *memory = ::mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+		::close(file);
+
+		if(memory == MAP_FAILED) {
+			return false;
+		}
+
+		m_header 	 = static_cast<Header*>(memory);
+		m_slots 	 = reinterpret_cast<Slot*>(static_cast<char*>(memory) + HeaderSize);
+		m_mappedSize = size;
+
+		return true;
+	}
+
+public:
+
+	explicit MappedRing()
+		: m_header(0)
+		, m_slots(0)
+		, m_mappedSize(0)
+		, m_slotCount(0)
+	{}
+
+	~MappedRing() {
+		unmap();
+	}
+
+	MappedRing(MappedRing const &) = delete;
+	MappedRing & operator=(MappedRing const &) = delete;
+
+
+	static std::size_t sizeFor(std::uint32_t slotCount) {
+		return HeaderSize + std::size_t(slotCount) * sizeof(Slot);
+	}
+
+
+	//! Sizes the (new, empty) file for slotCount slots, maps it and makes
+	//! the header, which the caller fills in. Closes file either way.
+	bool create(int file, std::uint32_t slotCount)
+	{
+		unmap();
+
+		std::size_t const size = sizeFor(slotCount);
+
+		if(::ftruncate(file, off_t(size)) != 0)
+		{
+			::close(file);
+			return false;
+		}
+
+		if(!map(file, size)) {
+			return false;
+		}
+
+		// Fresh memory is all zeros, which is an empty ring.
+		new (m_header) Header;
+		m_header->slotCount = slotCount;
+		m_slotCount = slotCount;
+
+		return true;
+	}
+
+
+	//! Maps a ring someone else created, false if the file is too small for
+	//! the slots its header says it has. Closes file either way, the caller
+	//! checks the rest of the header.
+	bool attach(int file)
+	{
+		unmap();
+
+		struct stat info;
+
+		if(::fstat(file, &info) != 0 || std::size_t(info.st_size) < HeaderSize)
+		{
+			::close(file);
+			return false;
+		}
+
+		if(!map(file, std::size_t(info.st_size))) {
+			return false;
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if(sizeFor(m_header->slotCount) > m_mappedSize)
+		{
+			unmap();
+			return false;
+		}
+
+		m_slotCount = m_header->slotCount;
+
+		return true;
+	}
+
+
+	//! Whatever is in the ring stays in the file.
+	void unmap()
+	{
+		if(m_header)
+		{
+			::munmap(m_header, m_mappedSize);
+
+			m_header 	 = 0;
+			m_slots 	 = 0;
+			m_mappedSize = 0;
+			m_slotCount  = 0;
+		}
+	}
+
+
+	bool isMapped() const { return m_header != 0; }
+
+	Header * header() const { return m_header; }
+
+	std::uint32_t slotCount() const { return m_slotCount; }
+
+	Slot & operator[](std::size_t index) const { return m_slots[index]; }
+
+
+	//! Calls write(slot) to fill in the slot, then marks it as holding
+	//! sequence. A reader that sees the sequence sees what write() wrote.
+	//! Clearing the sequence acquires it, so the write a lap earlier (by
+	//! any thread) is ordered before this one.
+	template<typename Write>
+	static void publish(Slot & slot, std::uint64_t sequence, Write write)
+	{
+		slot.sequence.exchange(0, std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		write(slot);
+
+		slot.sequence.store(sequence + 1, std::memory_order_release);
+	}
+
+}; // class MappedRing
+
+
+} // namespace Dead
+
+
+#endif // #ifndef DEAD_DETAILS_MAPPED_RING_INCLUDED
@@ -0,0 +1,238 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Disruptor style broadcast for events with lots of subscribers (a global
+ *	tick, time of day changes). The publisher writes each event once into a
+ *	sequenced ring, every subscriber reads it at its own cursor when it gets
+ *	round to it, so the fan out is paid by the subscribers, in batches,
+ *	not by the publisher.
+ *
+ *	Dead::BroadcastChannel<TickEvent> ticks(1024);
+ *	Dead::BroadcastSubscriber<TickEvent> ai(ticks), audio(ticks);
+ *
+ *	ticks.publish(tick);									// Game loop.
+ *
+ *	ai.poll([&](TickEvent const & tick) { ... });			// Whenever AI runs, any thread.
+ *
+ *	The publisher can't get more than a ring ahead of the slowest
+ *	subscriber, tryPublish() returns false and publish() waits when it is.
+ *	One publishing thread per channel, subscribers can each be on their own
+ *	thread. Subscribe and unsubscribe while nothing is publishing (at setup).
+ *	Events are read in place, a handler's reference is good until poll()
+ *	returns.
+ */
+
+
+#ifndef DEAD_EVENTS_BROADCAST_CHANNEL_INCLUDED
+#define DEAD_EVENTS_BROADCAST_CHANNEL_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <Dead/Config/Compiler.hpp>
+#include <Dead/Config/Cpu.hpp>
+
+
+namespace Dead {
+
+
+//! A subscriber's read position, padded out to a cache line so subscribers
+//! on different threads don't slow each other down. Padded rather than
+//! aligned so subscribers can be new'ed before C++17.
+struct BroadcastCursor
+{
+	std::atomic<std::uint64_t> sequence;	//!< Next sequence to read.
+	char padding[DEAD_CACHE_LINE_SIZE - sizeof(std::atomic<std::uint64_t>)];
+
+	BroadcastCursor()
+		: sequence(0)
+	{}
+
+}; // struct BroadcastCursor
+
+
+template<typename Event>
+class BroadcastChannel
+{
+	std::vector<Event> 				m_ring;
+	std::uint64_t 					m_mask;
+	std::vector<BroadcastCursor*> 	m_cursors;
+
+	// A cache line of padding either side of m_published keeps it off the
+	// lines the subscribers read and the publisher writes. Padded rather
+	// than aligned, like BroadcastCursor, so channels can be new'ed too.
+	char 							m_padding[DEAD_CACHE_LINE_SIZE];
+
+	//! Everything before this has been published, subscribers poll it.
+	std::atomic<std::uint64_t> 		m_published;
+	char 							m_publishedPadding[DEAD_CACHE_LINE_SIZE - sizeof(std::atomic<std::uint64_t>)];
+
+	//! Publisher only. m_gate is the slowest cursor last time we looked,
+	//! the cursors are only read again when the ring looks full.
+	std::uint64_t 					m_next;
+	std::uint64_t 					m_gate;
+
+	std::uint64_t slowestCursor() const
+	{
+		std::uint64_t slowest = m_next;
+
+		for(std::size_t i = 0; i < m_cursors.size(); ++i) {
+			slowest = std::min(slowest, m_cursors[i]->sequence.load(std::memory_order_acquire));
+		}
+
+		return slowest;
+	}
+
+	static std::size_t roundUp(std::size_t capacity)
+	{
+		std::size_t size(1);
+
+		while(size < capacity) {
+			size <<= 1;
+		}
+
+		return size;
+	}
+
+public:
+
+	//! capacity is rounded up to a power of two.
+	explicit BroadcastChannel(std::size_t capacity = 1024)
+		: m_ring(roundUp(capacity))
+		, m_mask(m_ring.size() - 1)
+		, m_cursors()
+		, m_published(0)
+		, m_next(0)
+		, m_gate(0)
+	{}
+
+	BroadcastChannel(BroadcastChannel const &) = delete;
+	BroadcastChannel & operator=(BroadcastChannel const &) = delete;
+
+
+	std::size_t capacity() const { return m_ring.size(); }
+
+	std::size_t subscribers() const { return m_cursors.size(); }
+
+
+	//! Starts cursor at the next event published.
+	void subscribe(BroadcastCursor & cursor)
+	{
+		cursor.sequence.store(m_published.load(std::memory_order_acquire), std::memory_order_release);
+		m_cursors.push_back(&cursor);
+	}
+
+	void unsubscribe(BroadcastCursor const & cursor) {
+		m_cursors.erase(std::remove(m_cursors.begin(), m_cursors.end(), &cursor), m_cursors.end());
+	}
+
+
+	//! Publishes event unless the slowest subscriber is a whole ring behind.
+	bool tryPublish(Event const & event)
+	{
+		if(DEAD_UNLIKELY(m_next - m_gate >= m_ring.size()))
+		{
+			m_gate = slowestCursor();
+
+			if(m_next - m_gate >= m_ring.size()) {
+				return false;
+			}
+		}
+
+		m_ring[m_next & m_mask] = event;
+		m_published.store(++m_next, std::memory_order_release);
+
+		return true;
+	}
+
+
+	//! Publishes event, waiting for the slowest subscriber if it has to.
+	void publish(Event const & event)
+	{
+		while(!tryPublish(event)) {
+			std::this_thread::yield();
+		}
+	}
+
+
+	//! Sequence of the next event to be published.
+	std::uint64_t published() const { return m_published.load(std::memory_order_acquire); }
+
+
+	/*!
+	 *	Calls handler(event) for each event cursor hasn't seen, up to
+	 *	maxEvents, then moves the cursor on once for the whole batch.
+	 *	Returns how many.
+	 */
+	template<typename Handler>
+	std::size_t poll(BroadcastCursor & cursor, Handler handler, std::size_t maxEvents = std::size_t(-1)) const
+	{
+		std::uint64_t const start 	  = cursor.sequence.load(std::memory_order_relaxed);
+		std::uint64_t const available = m_published.load(std::memory_order_acquire);
+		std::uint64_t const end 	  = start + std::min<std::uint64_t>(available - start, maxEvents);
+
+		for(std::uint64_t sequence = start; sequence < end; ++sequence) {
+			handler(m_ring[sequence & m_mask]);
+		}
+
+		cursor.sequence.store(end, std::memory_order_release);
+
+		return std::size_t(end - start);
+	}
+
+}; // class BroadcastChannel
+
+
+/*!
+ *	Owns a cursor on a channel for as long as it lives.
+ */
+template<typename Event>
+class BroadcastSubscriber
+{
+	BroadcastChannel<Event> 	&m_channel;
+	BroadcastCursor 			m_cursor;
+
+public:
+
+	explicit BroadcastSubscriber(BroadcastChannel<Event> & channel)
+		: m_channel(channel)
+		, m_cursor()
+	{
+		m_channel.subscribe(m_cursor);
+	}
+
+	~BroadcastSubscriber() {
+		m_channel.unsubscribe(m_cursor);
+	}
+
+	BroadcastSubscriber(BroadcastSubscriber const &) = delete;
+	BroadcastSubscriber & operator=(BroadcastSubscriber const &) = delete;
+
+	template<typename Handler>
+	std::size_t poll(Handler handler, std::size_t maxEvents = std::size_t(-1)) {
+		return m_channel.poll(m_cursor, handler, maxEvents);
+	}
+
+	//! Events published that this subscriber hasn't read yet.
+	std::size_t pending() const {
+		return std::size_t(m_channel.published() - m_cursor.sequence.load(std::memory_order_relaxed));
+	}
+
+}; // class BroadcastSubscriber
+
+
+} // namespace Dead
+
+
+#endif // #ifndef DEAD_EVENTS_BROADCAST_CHANNEL_INCLUDED
@@ -0,0 +1,131 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Owner handles for queued events, an index into a table of generations.
+ *	Destroying an owner bumps its generation, so every event still queued
+ *	with the old handle goes stale at once, nothing has to find them. The
+ *	manager checks the handle (one load and compare) as it drains the queue
+ *	and skips stale events.
+ *
+ *	Index 0 is the no owner handle, its generation never changes so events
+ *	queued without an owner are always sent.
+ */
+
+
+#ifndef DEAD_EVENTS_EVENT_OWNERS_INCLUDED
+#define DEAD_EVENTS_EVENT_OWNERS_INCLUDED
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace Dead {
+
+
+struct EventOwner
+{
+	std::uint32_t index;
+	std::uint32_t generation;
+
+	EventOwner()
+		: index(0)
+		, generation(0)
+	{}
+
+	EventOwner(std::uint32_t ownerIndex, std::uint32_t ownerGeneration)
+		: index(ownerIndex)
+		, generation(ownerGeneration)
+	{}
+
+	bool operator==(EventOwner const & other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(EventOwner const & other) const { return !(*this == other); }
+
+}; // struct EventOwner
+
+
+class EventOwners
+{
+	std::vector<std::uint32_t> m_generations;
+	std::vector<std::uint32_t> m_free;
+
+public:
+
+	explicit EventOwners()
+		: m_generations(1, 0)
+		, m_free()
+	{}
+
+
+	//! A new owner, reusing a destroyed one's index when there is one.
+	EventOwner create()
+	{
+		if(!m_free.empty())
+		{
+			std::uint32_t const index = m_free.back();
+			m_free.pop_back();
+
+			return EventOwner(index, m_generations[index]);
+		}
+
+		m_generations.push_back(1);
+		return EventOwner(std::uint32_t(m_generations.size() - 1), 1);
+	}
+
+
+	//! Makes every handle to owner stale, false if it already was.
+	bool destroy(EventOwner const & owner)
+	{
+		if(owner.index == 0 || !isAlive(owner)) {
+			return false;
+		}
+
+		// Skip 0 when it wraps, so a handle can't come back to life early.
+		std::uint32_t &generation = m_generations[owner.index];
+		generation = (generation + 1 == 0) ? 1 : generation + 1;
+
+		m_free.push_back(owner.index);
+
+		return true;
+	}
+
+
+	bool isAlive(EventOwner const & owner) const {
+		return owner.index < m_generations.size() && m_generations[owner.index] == owner.generation;
+	}
+
+
+	//! Owners ever made, live or not (the table's size).
+	std::size_t capacity() const { return m_generations.size() - 1; }
+
+}; // class EventOwners
+
+
+namespace Details {
+
+
+//! Whether a queue policy stores owners, ie it has getNextEventOwner() (and
+//! an addToQueue() that takes one).
+template<typename EventQueue, typename = void>
+struct QueueHasOwners : std::false_type {};
+
+template<typename EventQueue>
+struct QueueHasOwners<EventQueue, decltype(void(std::declval<EventQueue &>().getNextEventOwner()))> : std::true_type {};
+
+
+} // namespace Details
+
+
+} // namespace Dead
+
+
+#endif // #ifndef DEAD_EVENTS_EVENT_OWNERS_INCLUDED
@@ -0,0 +1,205 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	What SimpleEventManager::next() returns, a one shot wait for an event
+ *	that a coroutine can co_await. The waiter lives in the awaiting
+ *	coroutine's frame and links itself into the manager's list for that id,
+ *	so waiting doesn't allocate and costs nothing until the event is sent.
+ *
+ *	Only used when DEAD_HAS_COROUTINES.
+ */
+
+
+#ifndef DEAD_EVENTS_EVENT_WAITER_INCLUDED
+#define DEAD_EVENTS_EVENT_WAITER_INCLUDED
+
+#include <Dead/Config/Compiler.hpp>
+
+#if defined(DEAD_HAS_COROUTINES)
+
+#include <coroutine>
+
+
+namespace Dead {
+
+
+/*!
+ *	Intrusive, doubly linked so a waiter can take itself off whichever list
+ *	it is on (eg when its coroutine is destroyed).
+ */
+template<typename EventPtr>
+struct EventWaiter
+{
+	EventWaiter 			*next;
+	EventWaiter 			**prevNext;		//!< Null when not on a list.
+	std::coroutine_handle<> handle;
+	EventPtr 				event;
+	bool 					(*accepts)(EventWaiter const &, EventPtr const &);
+
+	explicit EventWaiter(bool (*acceptsFunction)(EventWaiter const &, EventPtr const &))
+		: next(0)
+		, prevNext(0)
+		, handle()
+		, event()
+		, accepts(acceptsFunction)
+	{}
+
+	bool waiting() const { return prevNext != 0; }
+
+	void link(EventWaiter *& head)
+	{
+		next = head;
+
+		if(head) {
+			head->prevNext = &next;
+		}
+
+		head 	 = this;
+		prevNext = &head;
+	}
+
+	void unlink()
+	{
+		if(!prevNext) {
+			return;
+		}
+
+		*prevNext = next;
+
+		if(next) {
+			next->prevNext = prevNext;
+		}
+
+		next 	 = 0;
+		prevNext = 0;
+	}
+
+}; // struct EventWaiter
+
+
+//! Default predicate for next(), takes any event.
+struct AnyEvent
+{
+	template<typename EventPtr>
+	bool operator()(EventPtr const &) const { return true; }
+};
+
+
+/*!
+ *	co_await this to suspend until an event the predicate accepts is sent,
+ *	the result is the event's data.
+ *	Only valid until the coroutine next suspends, queued events are deleted
+ *	(by SimpleStack) once everyone has seen them.
+ */
+template<typename EventPtr, typename Predicate>
+class NextEvent : private EventWaiter<EventPtr>
+{
+	typedef EventWaiter<EventPtr> Waiter;
+
+	Waiter 		*&m_waiters;
+	Predicate 	m_predicate;
+
+	static bool acceptsEvent(Waiter const & waiter, EventPtr const & event) {
+		return static_cast<NextEvent const &>(waiter).m_predicate(event);
+	}
+
+public:
+
+	NextEvent(Waiter *& waiters, Predicate predicate)
+		: Waiter(&acceptsEvent)
+		, m_waiters(waiters)
+		, m_predicate(predicate)
+	{}
+
+	//! Coroutine destroyed while still waiting.
+	~NextEvent() {
+		Waiter::unlink();
+	}
+
+	NextEvent(NextEvent const &) = delete;
+	NextEvent & operator=(NextEvent const &) = delete;
+
+	bool await_ready() const { return false; }
+
+	void await_suspend(std::coroutine_handle<> handle)
+	{
+		Waiter::handle = handle;
+		Waiter::link(m_waiters);
+	}
+
+	EventPtr await_resume() const { return Waiter::event; }
+
+}; // class NextEvent
+
+
+namespace Details {
+
+
+/*!
+ *	Resumes every waiter on the list that accepts event, the rest stay.
+ *	The list is moved aside first, so a coroutine that waits on the same id
+ *	again while it is being resumed waits for the next event, not this one.
+ */
+#if defined(DEAD_COMPILER_GCC) && (__GNUC__ >= 12)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdangling-pointer"		// pending is empty again before it goes.
+#endif
+
+template<typename EventPtr>
+void resumeWaiters(EventWaiter<EventPtr> *& waiters, EventPtr const & event)
+{
+	EventWaiter<EventPtr> *pending = waiters;
+
+	waiters = 0;
+	pending->prevNext = &pending;
+
+	while(pending)
+	{
+		EventWaiter<EventPtr> &waiter = *pending;
+		waiter.unlink();
+
+		if(waiter.accepts(waiter, event))
+		{
+			// The waiter might be gone once this returns.
+			waiter.event = event;
+			waiter.handle.resume();
+		}
+		else
+		{
+			waiter.link(waiters);
+		}
+	}
+}
+
+#if defined(DEAD_COMPILER_GCC) && (__GNUC__ >= 12)
+#pragma GCC diagnostic pop
+#endif
+
+
+//! Forgets every waiter on the list, they are left suspended.
+template<typename EventPtr>
+void releaseWaiters(EventWaiter<EventPtr> *& waiters)
+{
+	while(waiters) {
+		waiters->unlink();
+	}
+}
+
+
+} // namespace Details
+
+
+} // namespace Dead
+
+
+#endif // DEAD_HAS_COROUTINES
+
+#endif // #ifndef DEAD_EVENTS_EVENT_WAITER_INCLUDED
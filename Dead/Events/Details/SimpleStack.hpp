@@ -12,13 +12,14 @@
 #define DEAD_EVENTS_SIMPLE_STACK
 
 #include <stack>
+#include <Dead/Events/Details/EventOwners.hpp>
 
 namespace Dead {
 
 template<typename EventID, typename EventPtr>
 struct SimpleStack
 {
-	struct StackEvent { EventID id; EventPtr event; };
+	struct StackEvent { EventID id; EventPtr event; EventOwner owner; };
 	//struct StackEvent { EventID id; Event *event; };
 
 	typedef typename std::stack<StackEvent> EventStack;
@@ -31,9 +32,9 @@ struct SimpleStack
 
 
 	//void addToQueue(Event *data, EventID const &id)
-	void addToQueue(EventPtr data, EventID const &id)
+	void addToQueue(EventPtr data, EventID const &id, EventOwner const &owner = EventOwner())
 	{
-		StackEvent event = {id, data};
+		StackEvent event = {id, data, owner};
 
 		m_stack.push(event);
 	}
@@ -47,6 +48,10 @@ struct SimpleStack
 		return m_stack.top().id;
 	}
 
+	EventOwner const & getNextEventOwner() const {
+		return m_stack.top().owner;
+	}
+
 	bool popEvent()
 	{
 		if(!empty())
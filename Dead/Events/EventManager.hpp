@@ -11,4 +11,9 @@
 #include <Dead/Events/Details/SimpleStack.hpp>
 #include <Dead/Events/Details/SimpleStackNoDelete.hpp>
 
+// Coroutine scripts
+#if defined(DEAD_HAS_COROUTINES)
+#include <Dead/Events/EventTask.hpp>
+#endif
+
 #endif // include guard
\ No newline at end of file
@@ -0,0 +1,231 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Coroutine type for gameplay scripts that wait on events (C++20).
+ *
+ *	Dead::EventTask waitForDeath(EventManager & eventMgr, Player & player)
+ *	{
+ *		co_await eventMgr.next(GAME_START_MSG);
+ *
+ *		IEvent *event = co_await eventMgr.next(PLAYER_DEAD_MSG, [&](IEvent * e) { return e->player == &player; });
+ *		player.respawn();
+ *	}
+ *
+ *	m_script = waitForDeath(eventMgr, *this);	// Runs to the first co_await.
+ *
+ *	The coroutine is resumed from inside fireInstantEvent / fireQueuedEvents
+ *	when its event is sent. The EventTask owns the coroutine, destroying it
+ *	(or cancel()) stops the script and takes it off the manager.
+ *	Frames come from a per thread pool, so starting a script once its frame
+ *	size has been seen doesn't hit the heap. Scripts mustn't throw.
+ */
+
+
+#ifndef DEAD_EVENTS_EVENT_TASK_INCLUDED
+#define DEAD_EVENTS_EVENT_TASK_INCLUDED
+
+#include <Dead/Config/Compiler.hpp>
+
+#if !defined(DEAD_HAS_COROUTINES)
+#error "Dead/Events/EventTask.hpp needs C++20 coroutines."
+#endif
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+
+
+namespace Dead {
+
+
+namespace Details {
+
+
+/*!
+ *	Free lists of coroutine frames by size, in 64 byte steps up to 1 KiB,
+ *	bigger frames go straight to the heap. One per thread, so no locking.
+ */
+class CoroutineFramePool
+{
+	enum { GRANULE = 64, CLASSES = 16 };
+
+	struct FreeFrame { FreeFrame *next; };
+
+	FreeFrame *m_free[CLASSES];
+
+	CoroutineFramePool()
+	{
+		for(int i = 0; i < CLASSES; ++i) {
+			m_free[i] = 0;
+		}
+	}
+
+	~CoroutineFramePool()
+	{
+		threadPoolDestroyed() = true;
+
+		for(int i = 0; i < CLASSES; ++i)
+		{
+			while(FreeFrame *frame = m_free[i])
+			{
+				m_free[i] = frame->next;
+				::operator delete(frame);
+			}
+		}
+	}
+
+	// Frames can outlive the pool (static tasks), those just use the heap.
+	static bool & threadPoolDestroyed()
+	{
+		static thread_local bool destroyed(false);
+		return destroyed;
+	}
+
+	static CoroutineFramePool * threadPool()
+	{
+		static thread_local CoroutineFramePool pool;
+		return threadPoolDestroyed() ? 0 : &pool;
+	}
+
+	static std::size_t sizeClass(std::size_t size) {
+		return (size + GRANULE - 1) / GRANULE - 1;
+	}
+
+public:
+
+	static void * allocate(std::size_t size)
+	{
+		std::size_t const index = sizeClass(size);
+		CoroutineFramePool *pool = threadPool();
+
+		if(index >= CLASSES || !pool) {
+			return ::operator new(size);
+		}
+
+		if(FreeFrame *frame = pool->m_free[index])
+		{
+			pool->m_free[index] = frame->next;
+			return frame;
+		}
+
+		return ::operator new((index + 1) * GRANULE);
+	}
+
+	static void deallocate(void * memory, std::size_t size)
+	{
+		std::size_t const index = sizeClass(size);
+		CoroutineFramePool *pool = threadPool();
+
+		if(index >= CLASSES || !pool)
+		{
+			::operator delete(memory);
+			return;
+		}
+
+		FreeFrame *frame = static_cast<FreeFrame *>(memory);
+		frame->next = pool->m_free[index];
+		pool->m_free[index] = frame;
+	}
+
+}; // class CoroutineFramePool
+
+
+} // namespace Details
+
+
+/*!
+ *	Owns a script coroutine. Starts straight away, resumes on events.
+ */
+class EventTask
+{
+public:
+
+	struct promise_type
+	{
+		EventTask get_return_object() {
+			return EventTask(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_never initial_suspend() noexcept { return std::suspend_never(); }
+		std::suspend_always final_suspend() noexcept { return std::suspend_always(); }
+
+		void return_void() {}
+
+		// Would unwind through the event manager mid send.
+		void unhandled_exception() { std::terminate(); }
+
+		static void * operator new(std::size_t size) {
+			return Details::CoroutineFramePool::allocate(size);
+		}
+
+		static void operator delete(void * memory, std::size_t size) {
+			Details::CoroutineFramePool::deallocate(memory, size);
+		}
+	};
+
+	EventTask()
+		: m_handle()
+	{}
+
+	EventTask(EventTask && other) noexcept
+		: m_handle(other.m_handle)
+	{
+		other.m_handle = nullptr;
+	}
+
+	EventTask & operator=(EventTask && other) noexcept
+	{
+		if(this != &other)
+		{
+			cancel();
+			m_handle 		= other.m_handle;
+			other.m_handle 	= nullptr;
+		}
+
+		return *this;
+	}
+
+	~EventTask() {
+		cancel();
+	}
+
+	EventTask(EventTask const &) = delete;
+	EventTask & operator=(EventTask const &) = delete;
+
+	//! True once the script has returned (or there isn't one).
+	bool done() const { return !m_handle || m_handle.done(); }
+
+	//! Stops the script wherever it is waiting.
+	void cancel()
+	{
+		if(m_handle)
+		{
+			m_handle.destroy();
+			m_handle = nullptr;
+		}
+	}
+
+private:
+
+	explicit EventTask(std::coroutine_handle<promise_type> handle)
+		: m_handle(handle)
+	{}
+
+	std::coroutine_handle<promise_type> m_handle;
+
+}; // class EventTask
+
+
+} // namespace Dead
+
+
+#endif // #ifndef DEAD_EVENTS_EVENT_TASK_INCLUDED
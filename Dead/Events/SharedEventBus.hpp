@@ -0,0 +1,321 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Passes events between processes on the same machine (editor, profiler,
+ *	headless simulation) through a ring in shared memory.
+ *
+ *	struct TransformEvent { std::uint32_t entity; float position[3]; };
+ *	typedef Dead::SharedEventBus<EnumEvents, TransformEvent> TransformBus;
+ *
+ *	// The game.
+ *	TransformBus bus;
+ *	bus.create("/game-transforms", 4096);
+ *	bus.publish(ENTITY_MOVED_MSG, event);		// Eg from a controller subscribed to the ids to share.
+ *
+ *	// The editor.
+ *	TransformBus bus;
+ *	bus.attach("/game-transforms");
+ *	Dead::SharedEventCursor cursor = bus.subscribe();
+ *
+ *	bus.forward(cursor, eventMgr);				// Once a frame, fires each new event into eventMgr.
+ *
+ *	Payloads (and ids) have to be trivially copyable, they are copied into
+ *	the ring as they are. Any number of processes can publish and read, a
+ *	publish is one atomic add and a copy into the slot. Readers never write
+ *	to the ring and never hold up publishers, a reader that falls a whole
+ *	ring behind skips ahead and counts what it missed in cursor.lost.
+ *	Names are shm_open names ("/something"). POSIX only.
+ */
+
+
+#ifndef DEAD_EVENTS_SHARED_EVENT_BUS_INCLUDED
+#define DEAD_EVENTS_SHARED_EVENT_BUS_INCLUDED
+
+#include <Dead/Config/Platform.hpp>
+
+#if !defined(DEAD_ON_POSIX)
+#error The shared event bus needs shm_open, it is POSIX only.
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <Dead/Config/Cpu.hpp>
+#include <Dead/Details/MappedRing.hpp>
+
+
+namespace Dead {
+
+
+/*!
+ *	Start of the shared memory, a MappedRing. next is on its own cache
+ *	line, every publisher hits it.
+ */
+struct SharedEventBusHeader
+{
+	char 										magic[8];
+	std::uint32_t 								slotSize;
+	std::uint32_t 								slotCount;
+	std::uint32_t 								idSize;
+	std::uint32_t 								payloadSize;
+	alignas(DEAD_CACHE_LINE_SIZE) std::atomic<std::uint64_t> 	next;
+
+}; // struct SharedEventBusHeader
+
+
+//! A cache line (or a few) each.
+template<typename EventID, typename Payload>
+struct alignas(DEAD_CACHE_LINE_SIZE) SharedEventSlot
+{
+	std::atomic<std::uint64_t> 	sequence;
+	EventID 					id;
+	Payload 					payload;
+
+}; // struct SharedEventSlot
+
+
+static char const SHARED_EVENT_BUS_MAGIC[8] = { 'D', 'E', 'A', 'D', 'B', 'U', 'S', '1' };
+
+
+//! Where a reader is up to, one per reader.
+struct SharedEventCursor
+{
+	std::uint64_t next;		//!< Sequence of the next event to read.
+	std::uint64_t lost;		//!< Events that were overwritten before they were read.
+
+}; // struct SharedEventCursor
+
+
+/*!
+ *	One mapping of a bus. Not copyable, close() (or the destructor) unmaps
+ *	it, the bus itself lives until remove().
+ */
+template<typename EventID, typename Payload>
+class SharedEventBus
+{
+	static_assert(std::is_trivially_copyable<EventID>::value, "Shared event ids must be trivially copyable.");
+	static_assert(std::is_trivially_copyable<Payload>::value, "Shared event payloads must be trivially copyable.");
+
+	typedef SharedEventSlot<EventID, Payload> 			Slot;
+	typedef MappedRing<SharedEventBusHeader, Slot> 		Ring;
+
+	Ring 			m_ring;
+	std::uint64_t 	m_mask;
+
+	//! Slots are found by masking the sequence, so this has to hold for a
+	//! bus we make and for one we attach to.
+	static bool isValidSlotCount(std::uint32_t slotCount) {
+		return slotCount != 0 && (slotCount & (slotCount - 1)) == 0;
+	}
+
+public:
+
+	explicit SharedEventBus()
+		: m_ring()
+		, m_mask(0)
+	{}
+
+	SharedEventBus(SharedEventBus const &) = delete;
+	SharedEventBus & operator=(SharedEventBus const &) = delete;
+
+
+	//! Makes a new, empty bus called name and maps it. slotCount must be a
+	//! power of two. Replaces any old bus of that name, processes still on
+	//! the old one keep it until they close().
+	bool create(char const * name, std::uint32_t slotCount = 1024)
+	{
+		close();
+
+		if(!isValidSlotCount(slotCount)) {
+			return false;
+		}
+
+		::shm_unlink(name);
+
+		int const file = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+
+		if(file < 0) {
+			return false;
+		}
+
+		if(!m_ring.create(file, slotCount))
+		{
+			::shm_unlink(name);
+			return false;
+		}
+
+		SharedEventBusHeader &header = *m_ring.header();
+		header.slotSize 	= sizeof(Slot);
+		header.idSize 		= sizeof(EventID);
+		header.payloadSize 	= sizeof(Payload);
+		header.next.store(0, std::memory_order_relaxed);
+		m_mask = slotCount - 1;
+
+		// Magic last, so attach() doesn't take a half made bus.
+		std::atomic_thread_fence(std::memory_order_release);
+		std::memcpy(header.magic, SHARED_EVENT_BUS_MAGIC, sizeof(SHARED_EVENT_BUS_MAGIC));
+
+		return true;
+	}
+
+
+	//! Maps a bus another process created. Fails if there isn't one (yet) or
+	//! it was made for a different EventID / Payload.
+	bool attach(char const * name)
+	{
+		close();
+
+		int const file = ::shm_open(name, O_RDWR, 0600);
+
+		if(file < 0) {
+			return false;
+		}
+
+		if(!m_ring.attach(file)) {
+			return false;
+		}
+
+		SharedEventBusHeader const &header = *m_ring.header();
+
+		if(std::memcmp(header.magic, SHARED_EVENT_BUS_MAGIC, sizeof(SHARED_EVENT_BUS_MAGIC)) != 0
+			|| header.slotSize != sizeof(Slot) || header.idSize != sizeof(EventID) || header.payloadSize != sizeof(Payload)
+			|| !isValidSlotCount(header.slotCount))
+		{
+			close();
+			return false;
+		}
+
+		m_mask = header.slotCount - 1;
+
+		return true;
+	}
+
+
+	void close()
+	{
+		m_ring.unmap();
+		m_mask = 0;
+	}
+
+
+	//! Deletes the bus name, mappings that are open stay valid.
+	static bool remove(char const * name) {
+		return ::shm_unlink(name) == 0;
+	}
+
+
+	bool isOpen() const { return m_ring.isMapped(); }
+
+	std::uint32_t slotCount() const { return m_ring.slotCount(); }
+
+
+	//! Copies the event into the next slot, every reader will see it.
+	void publish(EventID const & id, Payload const & payload)
+	{
+		if(!m_ring.isMapped()) {
+			return;
+		}
+
+		std::uint64_t const sequence = m_ring.header()->next.fetch_add(1, std::memory_order_relaxed);
+
+		Ring::publish(m_ring[sequence & m_mask], sequence, [&](Slot & slot)
+		{
+			std::memcpy(&slot.id, &id, sizeof(EventID));
+			std::memcpy(&slot.payload, &payload, sizeof(Payload));
+		});
+	}
+
+
+	//! A cursor that reads from the next event published.
+	SharedEventCursor subscribe() const
+	{
+		SharedEventCursor cursor = { m_ring.isMapped() ? m_ring.header()->next.load(std::memory_order_acquire) : 0, 0 };
+		return cursor;
+	}
+
+
+	/*!
+	 *	Calls handler(id, payload) for each event published since the cursor
+	 *	last read, up to maxEvents, and returns how many.
+	 *	Each one is copied out of its slot and checked it wasn't overwritten
+	 *	while copying, so the handler never sees a torn payload.
+	 *	Stops at a slot that is still being written.
+	 */
+	template<typename Handler>
+	std::size_t poll(SharedEventCursor & cursor, Handler handler, std::size_t maxEvents = std::size_t(-1)) const
+	{
+		std::size_t count(0);
+
+		while(m_ring.isMapped() && count < maxEvents)
+		{
+			Slot const &slot = m_ring[cursor.next & m_mask];
+			std::uint64_t const sequence = slot.sequence.load(std::memory_order_acquire);
+
+			if(sequence != cursor.next + 1)
+			{
+				std::uint64_t const next = m_ring.header()->next.load(std::memory_order_acquire);
+
+				// Not published yet.
+				if(next - cursor.next <= m_mask + 1) {
+					break;
+				}
+
+				// Lapped, skip to the oldest event still in the ring.
+				std::uint64_t const oldest = next - (m_mask + 1);
+				cursor.lost += oldest - cursor.next;
+				cursor.next  = oldest;
+				continue;
+			}
+
+			EventID id;
+			Payload payload;
+			std::memcpy(&id, &slot.id, sizeof(EventID));
+			std::memcpy(&payload, &slot.payload, sizeof(Payload));
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			// Overwritten while copying, the next pass sees we were lapped.
+			if(slot.sequence.load(std::memory_order_relaxed) != sequence) {
+				continue;
+			}
+
+			++cursor.next;
+			++count;
+
+			handler(id, payload);
+		}
+
+		return count;
+	}
+
+
+	//! poll() into a SimpleEventManager, each event is sent as an instant
+	//! event with a pointer to the payload (so its EventPtr has to take a
+	//! Payload*), only valid during the send.
+	template<typename EventManager>
+	std::size_t forward(SharedEventCursor & cursor, EventManager & eventMgr, std::size_t maxEvents = std::size_t(-1)) const
+	{
+		return poll(cursor, [&eventMgr](EventID const & id, Payload & payload) {
+			eventMgr.fireInstantEvent(&payload, id);
+		}, maxEvents);
+	}
+
+}; // class SharedEventBus
+
+
+} // namespace Dead
+
+
+#endif // #ifndef DEAD_EVENTS_SHARED_EVENT_BUS_INCLUDED
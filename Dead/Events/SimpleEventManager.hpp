@@ -10,6 +10,9 @@
 #include <list>
 #include <map>
 #include <Dead/Events/Details/SimpleStack.hpp>
+#include <Dead/Events/Details/EventOwners.hpp>
+#include <Dead/Events/Details/EventWaiter.hpp>
+#include <Dead/Trace.hpp>
 
 namespace Dead {
 
@@ -28,6 +31,14 @@ class SimpleEventManager : public EventQueue
 
 
 	EventControllerMap 	m_controllers;
+	EventOwners 		m_owners;
+
+	#if defined(DEAD_HAS_COROUTINES)
+	typedef EventWaiter<EventPtr> 							Waiter;
+	typedef typename std::map<EventID, Waiter*>				EventWaiterMap;
+
+	EventWaiterMap 		m_waiters;
+	#endif
 
 	using EventQueue::addToQueue;
 	using EventQueue::getNextEvent;
@@ -36,15 +47,35 @@ class SimpleEventManager : public EventQueue
 	using EventQueue::size;
 	using EventQueue::empty;
 
+	// Queue policies without owners queue everything as owned by no one.
+	bool isNextEventOwnerAlive(std::true_type) {
+		return m_owners.isAlive(EventQueue::getNextEventOwner());
+	}
+
+	bool isNextEventOwnerAlive(std::false_type) {
+		return true;
+	}
+
 public:
 
 
 	explicit SimpleEventManager()
 		: m_controllers()
+		, m_owners()
+		#if defined(DEAD_HAS_COROUTINES)
+		, m_waiters()
+		#endif
 	{}
 
-	~SimpleEventManager() {
+	~SimpleEventManager()
+	{
 		m_controllers.clear();
+
+		#if defined(DEAD_HAS_COROUTINES)
+		for(typename EventWaiterMap::iterator it = m_waiters.begin(); it != m_waiters.end(); ++it) {
+			Details::releaseWaiters(it->second);
+		}
+		#endif
 	}
 
 
@@ -139,17 +170,43 @@ public:
 	}
 
 
-	//! Fire all the queued events off.
+	//! Queue an event on behalf of an owner (see createOwner()), it won't be
+	//! sent if the owner is destroyed first. Needs a queue policy that
+	//! stores owners.
+	void addQueuedEvent(EventPtr data, EventID const &id, EventOwner const &owner)
+	{
+		static_assert(Details::QueueHasOwners<EventQueue>::value, "This queue policy doesn't store owners, it needs getNextEventOwner() and a 3 argument addToQueue().");
+		EventQueue::addToQueue(data, id, owner);
+	}
+
+
+	//! Fire all the queued events off. Events whose owner has been
+	//! destroyed are dropped (and deleted by the queue policy as usual).
 	void fireQueuedEvents()
 	{
+		DEAD_TRACE_SCOPE("fireQueuedEvents");
+
 		while(!EventQueue::empty())
 		{
-			sendEvent(EventQueue::getNextEvent(), EventQueue::getNextEventID());
+			if(isNextEventOwnerAlive(Details::QueueHasOwners<EventQueue>())) {
+				sendEvent(EventQueue::getNextEvent(), EventQueue::getNextEventID());
+			}
+
 			popEvent();
 		}
 	}
 
 
+	//! A handle for something that queues events, eg an entity.
+	EventOwner createOwner() { return m_owners.create(); }
+
+	//! Drops every queued event of owner, however many, without touching
+	//! the queue. False if it was already destroyed.
+	bool destroyOwner(EventOwner const & owner) { return m_owners.destroy(owner); }
+
+	bool isOwnerAlive(EventOwner const & owner) const { return m_owners.isAlive(owner); }
+
+
 	//! How big the queue is.
 	std::size_t sizeOfQueue() const { return EventQueue::size(); }
 
@@ -163,6 +220,24 @@ public:
 	}
 
 
+	#if defined(DEAD_HAS_COROUTINES)
+
+	//! co_await in a coroutine (eg an EventTask) to wait for the next event
+	//! with this id, gives the event's data. Waiters are resumed when the
+	//! event is sent, before the controllers, and can't swallow it.
+	NextEvent<EventPtr, AnyEvent> next(EventID const & id) {
+		return NextEvent<EventPtr, AnyEvent>(m_waiters[id], AnyEvent());
+	}
+
+	//! As above, but keeps waiting until predicate(data) returns true.
+	template<typename Predicate>
+	NextEvent<EventPtr, Predicate> next(EventID const & id, Predicate predicate) {
+		return NextEvent<EventPtr, Predicate>(m_waiters[id], predicate);
+	}
+
+	#endif
+
+
 private:
 
 	//! This actually sends the event. The process is the the same for
@@ -170,6 +245,19 @@ private:
 	//void sendEvent(Event const * data, EventID const & id)
 	void sendEvent(const EventPtr data, EventID const & id)
 	{
+		#if defined(DEAD_HAS_COROUTINES)
+		if(!m_waiters.empty())
+		{
+			typename EventWaiterMap::iterator waiterIt = m_waiters.find(id);
+
+			if(waiterIt != m_waiters.end() && waiterIt->second)
+			{
+				DEAD_TRACE_SCOPE("resumeWaiters");
+				Details::resumeWaiters(waiterIt->second, data);
+			}
+		}
+		#endif
+
 		EventControllerIt eventControlerIt = m_controllers.find(id);
 
 		if(eventControlerIt != m_controllers.end())
@@ -180,7 +268,12 @@ private:
 
 			for(listIt; listIt != list.end(); ++listIt)
 			{
-				bool swallow = (*listIt)->receiveEvent(id, data);
+				bool swallow;
+
+				{
+					DEAD_TRACE_SCOPE("receiveEvent");
+					swallow = (*listIt)->receiveEvent(id, data);
+				}
 
 				// Break if the message has been swallowed.
 				if(swallow) {
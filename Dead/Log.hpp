@@ -20,11 +20,18 @@
 #include <Dead/Config/Platform.hpp>
 #include <Dead/Log/Logger.hpp>
 #include <Dead/Log/LoggerPolicies.hpp>
+#include <Dead/Log/RateLimit.hpp>
+#include <Dead/Log/RecordHeader.hpp>
+#include <Dead/Log/TeeOutput.hpp>
 
 #if defined(DEAD_ON_WINDOWS)
 #include <Dead/Log/WindowsAppConsolePolicies.hpp>
 #endif
 
+#if defined(DEAD_ON_POSIX)
+#include <Dead/Log/FlightRecorder.hpp>
+#endif
+
 
 namespace Dead {
 
@@ -33,6 +40,8 @@ typedef Logger<ConsoleOutput> 	ConsoleLog;
 typedef Logger<FileOutput> 		FileLog;
 typedef Logger<ConsoleOutput> 	Log;
 
+typedef Logger<StampedOutput<ConsoleOutput> > 	StampedLog;
+
 
 } // namespace Dead
 
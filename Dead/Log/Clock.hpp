@@ -0,0 +1,150 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Cheap timestamps for log records.
+ *	TickClock::now() reads the cycle counter (rdtsc) where there is one and
+ *	falls back to CLOCK_MONOTONIC_COARSE, neither makes a syscall.
+ *	Ticks are turned into wall clock time with a calibration taken once,
+ *	call TickClock::calibrate() at startup so nothing stalls on it later.
+ *
+ *	Frame timers can use TickClock::now() as well, then frame times and log
+ *	lines line up to the nanosecond (with rdtsc, the coarse clock is only
+ *	good to a few milliseconds).
+ */
+
+
+#ifndef DEAD_LOG_CLOCK_INCLUDED
+#define DEAD_LOG_CLOCK_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <Dead/Config/Platform.hpp>
+#include <Dead/Config/Cpu.hpp>
+
+#if defined(DEAD_HAS_RDTSC) && !defined(DEAD_COMPILER_MSVC)
+#include <x86intrin.h>
+#elif defined(DEAD_HAS_RDTSC) && defined(DEAD_COMPILER_MSVC)
+#include <intrin.h>
+#elif defined(DEAD_ON_LINUX)
+#include <time.h>
+#endif
+
+
+namespace Dead {
+
+
+//! Pairs a tick reading with wall clock time, and how long a tick is.
+struct TickCalibration
+{
+	std::uint64_t 	ticks;
+	std::int64_t 	wallNs;
+	double 			nsPerTick;
+
+	//! Nanoseconds since the unix epoch for a tick reading.
+	std::int64_t toWallNs(std::uint64_t tick) const {
+		return wallNs + std::int64_t(double(std::int64_t(tick - ticks)) * nsPerTick);
+	}
+
+}; // struct TickCalibration
+
+
+class TickClock
+{
+	static std::int64_t wallNow()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	static std::int64_t steadyNow()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	static TickCalibration measure()
+	{
+		TickCalibration calibration;
+
+		#if defined(DEAD_HAS_RDTSC)
+
+		// Spin for a few milliseconds against the steady clock to find
+		// the counter's rate.
+		std::int64_t const  steadyStart = steadyNow();
+		std::uint64_t const tickStart 	= now();
+
+		while(steadyNow() - steadyStart < 10000000) {}
+
+		std::int64_t const  steadyEnd = steadyNow();
+		std::uint64_t const tickEnd	  = now();
+
+		calibration.nsPerTick = double(steadyEnd - steadyStart) / double(tickEnd - tickStart);
+
+		#else
+
+		calibration.nsPerTick = 1.0;
+
+		#endif
+
+		calibration.ticks 	= now();
+		calibration.wallNs 	= wallNow();
+
+		return calibration;
+	}
+
+public:
+
+	//! Raw tick reading.
+	static std::uint64_t now()
+	{
+		#if defined(DEAD_HAS_RDTSC)
+		return __rdtsc();
+		#elif defined(DEAD_ON_LINUX)
+		timespec time;
+		clock_gettime(CLOCK_MONOTONIC_COARSE, &time);
+		return std::uint64_t(time.tv_sec) * 1000000000u + std::uint64_t(time.tv_nsec);
+		#else
+		return std::uint64_t(steadyNow());
+		#endif
+	}
+
+
+	//! The calibration, measured on first use.
+	static TickCalibration const & calibration()
+	{
+		static TickCalibration const calibration = measure();
+		return calibration;
+	}
+
+
+	//! Measure the calibration now rather than on first use.
+	static void calibrate() {
+		calibration();
+	}
+
+}; // class TickClock
+
+
+//! Small sequential id for the calling thread, 1 for the first thread to ask.
+inline std::uint32_t currentThreadId()
+{
+	static std::atomic<std::uint32_t> nextId(1);
+	static thread_local std::uint32_t const id = nextId.fetch_add(1, std::memory_order_relaxed);
+
+	return id;
+}
+
+
+} // namespace Dead
+
+
+#endif // #ifndef DEAD_LOG_CLOCK_INCLUDED
@@ -0,0 +1,117 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Fixed size buffer that a log record gets formatted into.
+ *	Never allocates, a record that doesn't fit in Capacity is cut short and
+ *	ends with "..." so it's clear something is missing.
+ */
+
+
+#ifndef DEAD_LOG_RECORD_BUFFER_INCLUDED
+#define DEAD_LOG_RECORD_BUFFER_INCLUDED
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <streambuf>
+
+
+namespace Dead {
+
+
+//! A finished record's bytes, streams out with a single write().
+struct RecordText
+{
+	char const 	*data;
+	std::size_t size;
+
+}; // struct RecordText
+
+
+inline std::ostream & operator<<(std::ostream & out, RecordText const & text) {
+	return out.write(text.data, std::streamsize(text.size));
+}
+
+
+template<std::size_t Capacity>
+class RecordBuffer
+{
+	enum { MARKER_SIZE = 3 };
+
+	static_assert(Capacity > MARKER_SIZE, "RecordBuffer needs room for its truncation marker.");
+
+	//! Puts characters straight into the array, keeping room at the end for
+	//! the marker. overflow() fails once it's full, which stops the stream
+	//! writing any further.
+	struct Buffer : public std::streambuf
+	{
+		char m_data[Capacity];
+		bool m_truncated;
+
+		Buffer()
+			: m_truncated(false)
+		{
+			setp(m_data, m_data + Capacity - MARKER_SIZE);
+		}
+
+		int_type overflow(int_type)
+		{
+			if(!m_truncated)
+			{
+				std::memcpy(pptr(), "...", MARKER_SIZE);
+				m_truncated = true;
+			}
+
+			return traits_type::eof();
+		}
+
+		std::size_t size() const { return (pptr() - pbase()) + (m_truncated ? MARKER_SIZE : 0); }
+	};
+
+	Buffer 			m_buffer;
+	std::ostream 	m_stream;
+
+public:
+
+	RecordBuffer()
+		: m_buffer()
+		, m_stream(&m_buffer)
+	{}
+
+	RecordBuffer(RecordBuffer const &) = delete;
+	RecordBuffer & operator=(RecordBuffer const &) = delete;
+
+	template<typename T>
+	RecordBuffer & operator<<(T const & value)
+	{
+		m_stream << value;
+		return *this;
+	}
+
+	char const * 	data() const { return m_buffer.m_data; }
+	std::size_t 	size() const { return m_buffer.size(); }
+	bool 			truncated() const { return m_buffer.m_truncated; }
+
+	RecordText text() const
+	{
+		RecordText text = { data(), size() };
+		return text;
+	}
+
+	static std::size_t capacity() { return Capacity; }
+
+}; // class RecordBuffer
+
+
+} // namespace Dead
+
+
+#endif // #ifndef DEAD_LOG_RECORD_BUFFER_INCLUDED
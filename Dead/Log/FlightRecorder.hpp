@@ -0,0 +1,376 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Crash safe flight recorder for the Logger.
+ *	Records go into a fixed size ring of slots inside a memory mapped file,
+ *	if the process dies the kernel still has the pages, so the last few
+ *	thousand lines can be pulled out of the file afterwards with
+ *	readFlightRecorder() (or Tools/FlightRecorderDump).
+ *
+ *	Dead::FlightRecorder::instance().open("Flight.rec");
+ *	Dead::Logger<Dead::FlightRecorderOutput>() << "Spawned " << count;
+ *
+ *	Logging formats into a stack buffer, takes a sequence number and copies
+ *	into the slot, it never makes a syscall. Each thread reserves a block of
+ *	sequence numbers with one atomic add, so busy threads don't all contend
+ *	on the shared counter. A block is given up after a millisecond, so a
+ *	thread that rarely logs doesn't later write old sequences over the
+ *	newest records. The reader orders records by time.
+ *	Each slot keeps the raw RecordHeader, the file header keeps the tick
+ *	calibration so the reader can turn it into wall clock time.
+ *	Records logged before open() are dropped.
+ *	POSIX only.
+ */
+
+
+#ifndef DEAD_LOG_FLIGHT_RECORDER_INCLUDED
+#define DEAD_LOG_FLIGHT_RECORDER_INCLUDED
+
+#include <Dead/Config/Platform.hpp>
+
+#if !defined(DEAD_ON_POSIX)
+#error The flight recorder needs mmap, it is POSIX only.
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <Dead/Details/MappedRing.hpp>
+#include <Dead/Log/Details/RecordBuffer.hpp>
+#include <Dead/Log/RecordHeader.hpp>
+
+
+namespace Dead {
+
+
+/*!
+ *	On disk layout, a MappedRing with the slots starting at SIZE.
+ */
+struct FlightRecorderHeader
+{
+	enum { SIZE = 64 };
+
+	char 						magic[8];
+	std::uint32_t 				slotSize;
+	std::uint32_t 				slotCount;
+	std::atomic<std::uint64_t> 	next;
+	std::uint64_t 				calibrationTicks;
+	std::int64_t 				calibrationWallNs;
+	double 						nsPerTick;
+
+}; // struct FlightRecorderHeader
+
+
+struct FlightRecorderSlot
+{
+	enum { SIZE = 256, TEXT_SIZE = SIZE - 24 };
+
+	std::atomic<std::uint64_t> 	sequence;
+	std::uint64_t 				ticks;
+	std::uint32_t 				thread;
+	std::uint16_t 				length;
+	std::uint8_t 				level;
+	std::uint8_t 				reserved;
+	char 						text[TEXT_SIZE];
+
+}; // struct FlightRecorderSlot
+
+
+static_assert(sizeof(FlightRecorderHeader) <= FlightRecorderHeader::SIZE, "FlightRecorderHeader grew past its slot.");
+static_assert(sizeof(FlightRecorderSlot) == FlightRecorderSlot::SIZE, "FlightRecorderSlot must match its on disk size.");
+
+static char const FLIGHT_RECORDER_MAGIC[8] = { 'D', 'E', 'A', 'D', 'F', 'R', '2', '\0' };
+
+
+/*!
+ *	The mapped ring, this is a singleton access through instance().
+ */
+class FlightRecorder
+{
+	typedef MappedRing<FlightRecorderHeader, FlightRecorderSlot, FlightRecorderHeader::SIZE> Ring;
+
+	Ring 					m_ring;
+	std::uint32_t 			m_blockSize;
+	std::uint64_t 			m_blockTicks;
+
+	//! Bumped by open(), so threads drop blocks reserved in an old file.
+	std::uint64_t 			m_epoch;
+
+	//! Sequences the calling thread has reserved, [next, end).
+	struct Reservation
+	{
+		std::uint64_t next, end, expires, epoch;
+	};
+
+	static Reservation & threadReservation()
+	{
+		static thread_local Reservation reservation = { 0, 0, 0, 0 };
+		return reservation;
+	}
+
+	enum { MAX_BLOCK_SIZE = 16 };
+
+	explicit FlightRecorder()
+		: m_ring()
+		, m_blockSize(0)
+		, m_blockTicks(0)
+		, m_epoch(0)
+	{}
+
+	~FlightRecorder() {
+		close();
+	}
+
+public:
+
+	//! Singleton access.
+	static FlightRecorder & instance()
+	{
+		static FlightRecorder recorder;
+		return recorder;
+	}
+
+
+	//! Creates (or truncates) the file and maps it. Call this once at
+	//! startup before any threads log.
+	//! False if slotCount is 0 or the file can't be made.
+	bool open(char const * path, std::uint32_t slotCount = 4096)
+	{
+		close();
+
+		if(slotCount == 0) {
+			return false;
+		}
+
+		int const file = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+		if(file < 0) {
+			return false;
+		}
+
+		if(!m_ring.create(file, slotCount)) {
+			return false;
+		}
+
+		FlightRecorderHeader &header = *m_ring.header();
+		std::memcpy(header.magic, FLIGHT_RECORDER_MAGIC, sizeof(FLIGHT_RECORDER_MAGIC));
+		header.slotSize = FlightRecorderSlot::SIZE;
+		header.next.store(0, std::memory_order_relaxed);
+
+		TickCalibration const & calibration = TickClock::calibration();
+		header.calibrationTicks  = calibration.ticks;
+		header.calibrationWallNs = calibration.wallNs;
+		header.nsPerTick 		 = calibration.nsPerTick;
+
+		// Small rings get small blocks, so the threads don't lap each other.
+		m_blockSize  = std::max<std::uint32_t>(1, std::min<std::uint32_t>(MAX_BLOCK_SIZE, slotCount / 64));
+		m_blockTicks = std::uint64_t(1000000.0 / calibration.nsPerTick);
+		++m_epoch;
+
+		return true;
+	}
+
+
+	//! Unmaps the file, whatever is in the ring stays in the file.
+	void close()
+	{
+		m_ring.unmap();
+		m_blockSize = 0;
+	}
+
+
+	bool isOpen() const { return m_ring.isMapped(); }
+
+
+	//! Copies a finished record into the next slot.
+	//! If a writer gets lapped by a whole ring while copying its slot can
+	//! end up torn, the ring has to be tiny (or the thread very stalled)
+	//! for that to happen.
+	void write(RecordHeader const & header, char const * text, std::size_t length)
+	{
+		if(!m_ring.isMapped()) {
+			return;
+		}
+
+		Reservation &reservation = threadReservation();
+
+		if(reservation.next == reservation.end || reservation.epoch != m_epoch || header.ticks > reservation.expires)
+		{
+			reservation.next 	= m_ring.header()->next.fetch_add(m_blockSize, std::memory_order_relaxed);
+			reservation.end 	= reservation.next + m_blockSize;
+			reservation.expires = header.ticks + m_blockTicks;
+			reservation.epoch 	= m_epoch;
+		}
+
+		std::uint64_t const sequence = reservation.next++;
+
+		length = std::min<std::size_t>(length, FlightRecorderSlot::TEXT_SIZE);
+
+		Ring::publish(m_ring[sequence % m_ring.slotCount()], sequence, [&](FlightRecorderSlot & slot)
+		{
+			std::memcpy(slot.text, text, length);
+			slot.ticks 	= header.ticks;
+			slot.thread = header.thread;
+			slot.length = std::uint16_t(length);
+			slot.level 	= std::uint8_t(header.level);
+		});
+	}
+
+}; // class FlightRecorder
+
+
+
+// *** FLIGHT RECORDER OUTPUT POLICY **** //
+
+//! Outputs each record into the FlightRecorder ring.
+class FlightRecorderOutput
+{
+	RecordHeader 								m_header;
+	RecordBuffer<FlightRecorderSlot::TEXT_SIZE> m_record;
+
+public:
+
+	explicit FlightRecorderOutput(LogLevel level = LOG_INFO)
+		: m_header(RecordHeader::capture(level))
+		, m_record()
+	{}
+
+	~FlightRecorderOutput() {
+		FlightRecorder::instance().write(m_header, m_record.data(), m_record.size());
+	}
+
+	template<typename T>
+	void out(T const & output) {
+		m_record << output;
+	}
+}; // class FlightRecorderOutput
+
+
+
+// *** READING IT BACK **** //
+
+//! A record pulled back out of a flight recorder file.
+struct FlightRecord
+{
+	std::uint64_t 	sequence;
+	RecordHeader 	header;
+	std::string 	text;
+
+}; // struct FlightRecord
+
+
+//! What readFlightRecorder() found in the file.
+struct FlightRecorderContents
+{
+	TickCalibration 			calibration;
+	std::vector<FlightRecord> 	records;
+
+}; // struct FlightRecorderContents
+
+
+//! Reads the tail out of a flight recorder file, oldest first (by time,
+//! sequence numbers are only in order within a thread). Only records
+//! from the newest slotCount sequences come back.
+//! Returns false if the file can't be read or isn't a flight recorder.
+//! Pass the record headers to formatRecordHeader() with contents.calibration
+//! to get readable times.
+inline bool readFlightRecorder(char const * path, FlightRecorderContents & contents)
+{
+	std::vector<FlightRecord> &records = contents.records;
+
+	std::ifstream file(path, std::ios::binary);
+
+	char header[FlightRecorderHeader::SIZE];
+
+	if(!file.read(header, sizeof(header))) {
+		return false;
+	}
+
+	if(std::memcmp(header, FLIGHT_RECORDER_MAGIC, sizeof(FLIGHT_RECORDER_MAGIC)) != 0) {
+		return false;
+	}
+
+	std::uint32_t slotSize, slotCount;
+	std::memcpy(&slotSize,  header + offsetof(FlightRecorderHeader, slotSize),  sizeof(slotSize));
+	std::memcpy(&slotCount, header + offsetof(FlightRecorderHeader, slotCount), sizeof(slotCount));
+
+	if(slotSize != FlightRecorderSlot::SIZE) {
+		return false;
+	}
+
+	TickCalibration &calibration = contents.calibration;
+	std::memcpy(&calibration.ticks,  	header + offsetof(FlightRecorderHeader, calibrationTicks),  sizeof(calibration.ticks));
+	std::memcpy(&calibration.wallNs, 	header + offsetof(FlightRecorderHeader, calibrationWallNs), sizeof(calibration.wallNs));
+	std::memcpy(&calibration.nsPerTick, header + offsetof(FlightRecorderHeader, nsPerTick), 		sizeof(calibration.nsPerTick));
+
+	std::vector<char> slot(slotSize);
+
+	for(std::uint32_t i = 0; i < slotCount && file.read(&slot[0], slotSize); ++i)
+	{
+		char const *bytes = &slot[0];
+
+		std::uint64_t sequence;
+		std::uint16_t length;
+		std::uint8_t  level;
+		std::memcpy(&sequence, bytes + offsetof(FlightRecorderSlot, sequence), sizeof(sequence));
+		std::memcpy(&length,   bytes + offsetof(FlightRecorderSlot, length),   sizeof(length));
+		std::memcpy(&level,    bytes + offsetof(FlightRecorderSlot, level),    sizeof(level));
+
+		// Empty, or the writer died half way through.
+		if(sequence == 0 || length > FlightRecorderSlot::TEXT_SIZE) {
+			continue;
+		}
+
+		FlightRecord record;
+		record.sequence 	= sequence - 1;
+		record.header.level = LogLevel(level);
+		std::memcpy(&record.header.ticks,  bytes + offsetof(FlightRecorderSlot, ticks),  sizeof(record.header.ticks));
+		std::memcpy(&record.header.thread, bytes + offsetof(FlightRecorderSlot, thread), sizeof(record.header.thread));
+		record.text.assign(bytes + offsetof(FlightRecorderSlot, text), length);
+
+		records.push_back(record);
+	}
+
+	// Threads leave unused sequences at the end of their blocks, whatever
+	// those slots held is from an earlier lap, older than the ring.
+	std::uint64_t newest(0);
+
+	for(std::size_t i = 0; i < records.size(); ++i) {
+		newest = std::max(newest, records[i].sequence);
+	}
+
+	if(newest >= slotCount)
+	{
+		std::uint64_t const oldest = newest - slotCount + 1;
+
+		records.erase(std::remove_if(records.begin(), records.end(),
+			[oldest](FlightRecord const & record) { return record.sequence < oldest; }), records.end());
+	}
+
+	std::sort(records.begin(), records.end(),
+		[](FlightRecord const & a, FlightRecord const & b) {
+			return (a.header.ticks != b.header.ticks) ? a.header.ticks < b.header.ticks : a.sequence < b.sequence;
+		});
+
+	return true;
+}
+
+
+} // namespace Dead
+
+
+#endif // #ifndef DEAD_LOG_FLIGHT_RECORDER_INCLUDED
@@ -29,6 +29,14 @@ class Logger : public OutputPolicy
 
 public:
 
+	Logger() {}
+
+	//! Hands an argument on to the policy, eg a LogLevel for StampedOutput.
+	template<class Arg>
+	explicit Logger(Arg const & arg)
+		: OutputPolicy(arg)
+	{}
+
 	template<class T>
     Logger & operator<<(T const & log)
     {
@@ -4,6 +4,8 @@
 /*!
  *	History
  *  March 2012, Phil CK added/created file
+ *  October 2026, FileOutput appends and flushes each record, it formats
+ *  the record first and only locks the file to write it.
  */
 
 
@@ -19,6 +21,8 @@
 
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <Dead/Log/Details/RecordBuffer.hpp>
 
 
 namespace Dead {
@@ -47,26 +51,44 @@ public:
 // *** FILE OUTPUT POLICY **** //
 
 //! Outputs contents to a file.
+//! The file is opened (and emptied) by the first record of the run and
+//! appended to after that. Each record is formatted on its own, then
+//! written and flushed under the file's lock, so records from different
+//! threads don't interleave and a record can log while it is formatted.
 class FileOutput
 {
 
-	std::ofstream logFile;
+	RecordBuffer<1024> m_record;
 
-public:
+	static std::mutex & fileMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
 
-	FileOutput() {
-	  	logFile.open ("LoggerOutput.txt");
+	static std::ofstream & logFile()
+	{
+		static std::ofstream file("LoggerOutput.txt");
+		return file;
 	}
 
-	~FileOutput() {
-		out("\n");
-		logFile.close();
+public:
+
+	FileOutput()
+		: m_record()
+	{}
+
+	~FileOutput()
+	{
+		std::lock_guard<std::mutex> lock(fileMutex());
+
+		logFile() << m_record.text() << "\n";
+		logFile().flush();
 	}
 
 	template<typename T>
-	void out(T const & output)
-	{
-		logFile << output;
+	void out(T const & output) {
+		m_record << output;
 	}
 
 }; // class FileOutput
@@ -0,0 +1,205 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Call site rate limiting for the Logger.
+ *	Each macro owns a static LogSite for the line it expands on, so a log
+ *	inside a hot loop can be thinned out without any setup.
+ *
+ *	DEAD_LOG_EVERY_N(Dead::Log, 1000) << "Lost packet " << seq;
+ *	DEAD_LOG_FIRST_N(Dead::Log, 10) << "Missing texture " << name;
+ *	DEAD_LOG_AT_MOST_PER_SECOND(Dead::Log, 5) << "Physics step overran";
+ *
+ *	When a message gets through after others were dropped it is prefixed
+ *	with "[suppressed X messages]".
+ *	A suppressed call costs one relaxed atomic increment and a branch,
+ *	DEAD_LOG_AT_MOST_PER_SECOND also reads TickClock (rdtsc, no syscall) and
+ *	compares it to the window end. Its first window opening measures the
+ *	tick calibration unless TickClock::calibrate() was called at startup.
+ *	A limit of 0 means never log.
+ */
+
+
+#ifndef DEAD_LOG_RATE_LIMIT_INCLUDED
+#define DEAD_LOG_RATE_LIMIT_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <Dead/Config/Compiler.hpp>
+#include <Dead/Config/Cpu.hpp>
+#include <Dead/Log/Clock.hpp>
+
+
+namespace Dead {
+
+
+/*!
+ *	Answer from a LogSite.
+ *	Converts to true when the call should be *dropped*, this is so the macros
+ *	can declare it in the if() and still use it in the else branch.
+ */
+class LogGate
+{
+	bool 			m_suppress;
+	std::uint64_t 	m_skipped;
+
+public:
+
+	LogGate(bool suppress, std::uint64_t skipped)
+		: m_suppress(suppress)
+		, m_skipped(skipped)
+	{}
+
+	explicit operator bool() const { return m_suppress; }
+
+	//! How many messages were dropped since this site last logged.
+	std::uint64_t skipped() const { return m_skipped; }
+
+}; // class LogGate
+
+
+//! Writes the suppressed summary, writes nothing if nothing was dropped.
+inline std::ostream & operator<<(std::ostream & out, LogGate const & gate)
+{
+	if(gate.skipped() > 0) {
+		out << "[suppressed " << gate.skipped() << " messages] ";
+	}
+
+	return out;
+}
+
+
+/*!
+ *	Per call site state. Constant initialised so the function statics the
+ *	macros create don't need a guard, and a cache line each so busy sites
+ *	don't slow down their neighbours.
+ */
+class alignas(DEAD_CACHE_LINE_SIZE) LogSite
+{
+	std::atomic<std::uint64_t> 	m_count;
+	std::atomic<std::uint64_t> 	m_windowEnd;	//!< In TickClock ticks.
+
+	static std::uint64_t oneSecond()
+	{
+		static std::uint64_t const ticks = std::uint64_t(1000000000.0 / TickClock::calibration().nsPerTick);
+		return ticks;
+	}
+
+public:
+
+	constexpr LogSite()
+		: m_count(0)
+		, m_windowEnd(0)
+	{}
+
+	LogSite(LogSite const &) = delete;
+	LogSite & operator=(LogSite const &) = delete;
+
+
+	//! Lets the 1st, (n+1)th, (2n+1)th ... calls through.
+	LogGate everyN(std::uint64_t n)
+	{
+		std::uint64_t const count = m_count.fetch_add(1, std::memory_order_relaxed);
+
+		if(DEAD_UNLIKELY(n == 0)) {
+			return LogGate(true, 0);
+		}
+
+		if(DEAD_LIKELY(count % n != 0)) {
+			return LogGate(true, 0);
+		}
+
+		return LogGate(false, count == 0 ? 0 : n - 1);
+	}
+
+
+	//! Lets the first n calls through and drops the rest.
+	LogGate firstN(std::uint64_t n)
+	{
+		std::uint64_t const count = m_count.fetch_add(1, std::memory_order_relaxed);
+
+		return LogGate(count >= n, 0);
+	}
+
+
+	//! Lets at most n calls through in each one second window.
+	LogGate atMostPerSecond(std::uint64_t n)
+	{
+		std::uint64_t const count = m_count.fetch_add(1, std::memory_order_relaxed);
+
+		if(DEAD_UNLIKELY(n == 0)) {
+			return LogGate(true, 0);
+		}
+
+		if(DEAD_UNLIKELY(count < n))
+		{
+			// Very first call opens the first window.
+			if(count == 0) {
+				m_windowEnd.store(TickClock::now() + oneSecond(), std::memory_order_relaxed);
+			}
+
+			return LogGate(false, 0);
+		}
+
+		std::uint64_t const time = TickClock::now();
+		std::uint64_t windowEnd  = m_windowEnd.load(std::memory_order_relaxed);
+
+		if(DEAD_LIKELY(time < windowEnd)) {
+			return LogGate(true, 0);
+		}
+
+		// Only one thread gets to open the next window, everyone else
+		// that raced us is counted as suppressed.
+		if(!m_windowEnd.compare_exchange_strong(windowEnd, time + oneSecond(), std::memory_order_relaxed)) {
+			return LogGate(true, 0);
+		}
+
+		std::uint64_t const seen = m_count.exchange(1, std::memory_order_relaxed);
+
+		return LogGate(false, seen > n + 1 ? seen - n - 1 : 0);
+	}
+
+
+	//! Total calls seen by this site (wraps every window for atMostPerSecond).
+	std::uint64_t calls() const { return m_count.load(std::memory_order_relaxed); }
+
+}; // class LogSite
+
+
+} // namespace Dead
+
+
+//! Static LogSite unique to the line this expands on.
+#define DEAD_LOG_SITE() \
+([]() -> Dead::LogSite & { static Dead::LogSite site; return site; }())
+
+
+//! Logs through LoggerType only if the gate lets it through.
+#define DEAD_LOG_GATED(LoggerType, gate) \
+if(Dead::LogGate const deadLogGate = (gate)) {} else LoggerType() << deadLogGate
+
+
+//! Log every n'th time this line is hit.
+#define DEAD_LOG_EVERY_N(LoggerType, n) \
+DEAD_LOG_GATED(LoggerType, DEAD_LOG_SITE().everyN(n))
+
+
+//! Log only the first n times this line is hit.
+#define DEAD_LOG_FIRST_N(LoggerType, n) \
+DEAD_LOG_GATED(LoggerType, DEAD_LOG_SITE().firstN(n))
+
+
+//! Log at most n times a second from this line.
+#define DEAD_LOG_AT_MOST_PER_SECOND(LoggerType, n) \
+DEAD_LOG_GATED(LoggerType, DEAD_LOG_SITE().atMostPerSecond(n))
+
+
+#endif // #ifndef DEAD_LOG_RATE_LIMIT_INCLUDED
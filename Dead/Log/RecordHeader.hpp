@@ -0,0 +1,165 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Optional header for log records, a raw tick timestamp, thread id and level.
+ *	Capturing it is a counter read and a thread local load, the ticks are only
+ *	turned into a readable time when the record is formatted.
+ *
+ *	StampedOutput puts the header in front of any text policy.
+ *	Dead::Logger<Dead::StampedOutput<Dead::ConsoleOutput> >(Dead::LOG_WARNING) << "Low health";
+ *	[2026-10-19 12:34:56.123456789] [T1] [WARNING] Low health
+ */
+
+
+#ifndef DEAD_LOG_RECORD_HEADER_INCLUDED
+#define DEAD_LOG_RECORD_HEADER_INCLUDED
+
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <type_traits>
+#include <Dead/Config/Platform.hpp>
+#include <Dead/Log/Clock.hpp>
+
+
+namespace Dead {
+
+
+enum LogLevel
+{
+	LOG_TRACE,
+	LOG_DEBUG,
+	LOG_INFO,
+	LOG_WARNING,
+	LOG_ERROR,
+	LOG_FATAL,
+};
+
+
+inline char const * logLevelName(LogLevel level)
+{
+	static char const * const names[] = { "TRACE", "DEBUG", "INFO", "WARNING", "ERROR", "FATAL" };
+
+	return (unsigned(level) <= LOG_FATAL) ? names[level] : "?";
+}
+
+
+struct RecordHeader
+{
+	std::uint64_t 	ticks;
+	std::uint32_t 	thread;
+	LogLevel 		level;
+
+	//! Stamp a record being logged now.
+	static RecordHeader capture(LogLevel level)
+	{
+		RecordHeader header = { TickClock::now(), currentThreadId(), level };
+		return header;
+	}
+
+}; // struct RecordHeader
+
+
+//! Writes "[YYYY-MM-DD HH:MM:SS.nnnnnnnnn] [Tn] [LEVEL] " (UTC) into buffer.
+//! Returns the length written, truncated to fit size.
+inline std::size_t formatRecordHeader(char * buffer, std::size_t size, RecordHeader const & header,
+									  TickCalibration const & calibration = TickClock::calibration())
+{
+	std::int64_t const wallNs 	= calibration.toWallNs(header.ticks);
+	std::time_t const seconds 	= std::time_t(wallNs / 1000000000);
+	long const nanoseconds 		= long(wallNs % 1000000000);
+
+	std::tm time;
+
+	#if defined(DEAD_ON_WINDOWS)
+	gmtime_s(&time, &seconds);
+	#else
+	gmtime_r(&seconds, &time);
+	#endif
+
+	int const length = std::snprintf(buffer, size, "[%04d-%02d-%02d %02d:%02d:%02d.%09ld] [T%u] [%s] ",
+		time.tm_year + 1900, time.tm_mon + 1, time.tm_mday,
+		time.tm_hour, time.tm_min, time.tm_sec, nanoseconds,
+		unsigned(header.thread), logLevelName(header.level));
+
+	if(length < 0) {
+		return 0;
+	}
+
+	return (std::size_t(length) < size) ? std::size_t(length) : size - 1;
+}
+
+
+
+// *** STAMPED OUTPUT POLICY **** //
+
+//! Stamps each record with a RecordHeader and writes it in front of the
+//! text through OutputPolicy.
+template<typename OutputPolicy>
+class StampedOutput : public OutputPolicy
+{
+	RecordHeader 	m_header;
+	bool 			m_headerWritten;
+
+	void writeHeader()
+	{
+		char buffer[64];
+		formatRecordHeader(buffer, sizeof(buffer), m_header);
+
+		m_headerWritten = true;
+		OutputPolicy::out(static_cast<char const *>(buffer));
+	}
+
+	// Policies that take a level (eg TeeOutput) get passed it as well.
+	StampedOutput(LogLevel level, std::true_type)
+		: OutputPolicy(level)
+		, m_header(RecordHeader::capture(level))
+		, m_headerWritten(false)
+	{}
+
+	StampedOutput(LogLevel level, std::false_type)
+		: OutputPolicy()
+		, m_header(RecordHeader::capture(level))
+		, m_headerWritten(false)
+	{}
+
+public:
+
+	explicit StampedOutput(LogLevel level = LOG_INFO)
+		: StampedOutput(level, std::is_constructible<OutputPolicy, LogLevel>())
+	{}
+
+	~StampedOutput()
+	{
+		if(!m_headerWritten) {
+			writeHeader();
+		}
+	}
+
+	template<typename T>
+	void out(T const & output)
+	{
+		if(!m_headerWritten) {
+			writeHeader();
+		}
+
+		OutputPolicy::out(output);
+	}
+
+	RecordHeader const & header() const { return m_header; }
+
+}; // class StampedOutput
+
+
+} // namespace Dead
+
+
+#endif // #ifndef DEAD_LOG_RECORD_HEADER_INCLUDED
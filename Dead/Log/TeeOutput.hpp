@@ -0,0 +1,133 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Sends each record to several output policies at once.
+ *	The record is formatted once into a stack buffer, then the finished
+ *	bytes are handed to every sink, the fan out is expanded at compile time
+ *	so there is no virtual dispatch. A record longer than 1024 bytes is cut
+ *	short and ends with "...".
+ *
+ *	typedef Dead::Logger<Dead::TeeOutput<Dead::Filtered<Dead::ConsoleOutput, Dead::LOG_WARNING>,
+ *										 Dead::FileOutput,
+ *										 Dead::FlightRecorderOutput> > GameLog;
+ *
+ *	GameLog(Dead::LOG_ERROR) << "Out of memory";
+ *
+ *	Sinks are constructed when the record is finished, and only if the
+ *	record's level passes their filter. A sink that takes a LogLevel in its
+ *	constructor (StampedOutput, FlightRecorderOutput) gets the record's level.
+ *	Like with Logger a sink lives for one record, anything that has to last
+ *	longer (an open file, a ring) is shared state the sink finds, the way
+ *	FileOutput and FlightRecorderOutput do.
+ *	Wrap the whole tee in StampedOutput to stamp the header once for everyone.
+ */
+
+
+#ifndef DEAD_LOG_TEE_OUTPUT_INCLUDED
+#define DEAD_LOG_TEE_OUTPUT_INCLUDED
+
+#include <type_traits>
+#include <Dead/Log/Details/RecordBuffer.hpp>
+#include <Dead/Log/RecordHeader.hpp>
+
+
+namespace Dead {
+
+
+//! Marks a TeeOutput sink as only wanting records at MinLevel or above.
+template<typename OutputPolicy, LogLevel MinLevel>
+struct Filtered {};
+
+
+namespace Details {
+
+
+template<typename Sink>
+struct TeeSink
+{
+	typedef Sink Policy;
+	static const LogLevel minLevel = LOG_TRACE;
+};
+
+
+template<typename OutputPolicy, LogLevel MinLevel>
+struct TeeSink<Filtered<OutputPolicy, MinLevel> >
+{
+	typedef OutputPolicy Policy;
+	static const LogLevel minLevel = MinLevel;
+};
+
+
+template<typename Policy>
+void teeWrite(RecordText const & text, LogLevel, std::false_type)
+{
+	Policy sink;
+	sink.out(text);
+}
+
+
+template<typename Policy>
+void teeWrite(RecordText const & text, LogLevel level, std::true_type)
+{
+	Policy sink(level);
+	sink.out(text);
+}
+
+
+} // namespace Details
+
+
+
+// *** TEE OUTPUT POLICY **** //
+
+//! Outputs each record to every one of Sinks.
+template<typename... Sinks>
+class TeeOutput
+{
+	RecordBuffer<1024> 	m_record;
+	LogLevel 			m_level;
+
+	template<typename Sink>
+	int writeTo() const
+	{
+		typedef typename Details::TeeSink<Sink>::Policy Policy;
+
+		if(m_level >= Details::TeeSink<Sink>::minLevel) {
+			Details::teeWrite<Policy>(m_record.text(), m_level, std::is_constructible<Policy, LogLevel>());
+		}
+
+		return 0;
+	}
+
+public:
+
+	explicit TeeOutput(LogLevel level = LOG_INFO)
+		: m_record()
+		, m_level(level)
+	{}
+
+	~TeeOutput()
+	{
+		int const expand[] = { 0, writeTo<Sinks>()... };
+		(void)expand;
+	}
+
+	template<typename T>
+	void out(T const & output) {
+		m_record << output;
+	}
+}; // class TeeOutput
+
+
+} // namespace Dead
+
+
+#endif // #ifndef DEAD_LOG_TEE_OUTPUT_INCLUDED
@@ -0,0 +1,320 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Micro benchmarks that live next to the unit tests.
+ *
+ *	BENCHMARK(FireQueuedEvents)
+ *	{
+ *		EventManager manager;			// Setup isn't timed.
+ *
+ *		while(state.keepRunning()) {
+ *			manager.fireQueuedEvents();
+ *		}
+ *	}
+ *
+ *	They register with UnitTest like TEST() does, but only run when
+ *	TestOptions::benchmarks is set (--benchmarks), one at a time after the
+ *	tests. The iteration count is grown until a sample takes a few
+ *	milliseconds, one sample is thrown away as a warm up, then mean, median,
+ *	stddev and min are reported through TestLogging. --benchmark-json=file
+ *	writes them out as one JSON object per line as well.
+ *	Where hardware counters are available (see PerfCounters.hpp) cycles,
+ *	instructions, IPC, cache and branch misses per iteration are reported
+ *	next to the times, otherwise the result says it is wall time only.
+ */
+
+
+#ifndef DEAD_BENCHMARK_INCLUDED
+#define DEAD_BENCHMARK_INCLUDED
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <math.h>
+#include <Dead/Test/UnitTest.hpp>
+#include <Dead/Test/PerfCounters.hpp>
+#include <Dead/Config/Compiler.hpp>
+
+#if defined(DEAD_COMPILER_MSVC)
+#include <intrin.h>
+#endif
+
+
+namespace Dead {
+
+
+//! Stops the compiler throwing away a value the benchmark computes.
+template<typename T>
+inline void DoNotOptimize(T const & value)
+{
+	#if defined(DEAD_COMPILER_MSVC)
+	static_cast<void>(*static_cast<volatile char const *>(static_cast<void const *>(&value)));
+	_ReadWriteBarrier();
+	#else
+	asm volatile("" : : "r,m"(value) : "memory");
+	#endif
+}
+
+
+//! Stops the compiler keeping memory in registers across this point.
+inline void ClobberMemory()
+{
+	#if defined(DEAD_COMPILER_MSVC)
+	_ReadWriteBarrier();
+	#else
+	asm volatile("" : : : "memory");
+	#endif
+}
+
+
+/*!
+ *	Passed to a benchmark body, loop on keepRunning(). Only the loop is
+ *	timed, not what comes before or after it.
+ */
+class BenchmarkState
+{
+	typedef std::chrono::steady_clock Clock;
+
+	std::uint64_t 		m_iterations, m_remaining;
+	Clock::time_point 	m_start, m_end;
+	PerfCounters 		*m_counters;
+
+public:
+
+	//! counters (if given) only run while the loop does.
+	explicit BenchmarkState(std::uint64_t iterations, PerfCounters * counters = 0)
+		: m_iterations(iterations)
+		, m_remaining(iterations)
+		, m_start()
+		, m_end()
+		, m_counters(counters)
+	{}
+
+	bool keepRunning()
+	{
+		if(m_remaining == 0)
+		{
+			m_end = Clock::now();
+
+			if(m_counters) {
+				m_counters->stop();
+			}
+
+			return false;
+		}
+
+		if(m_remaining-- == m_iterations)
+		{
+			if(m_counters) {
+				m_counters->start();
+			}
+
+			m_start = Clock::now();
+		}
+
+		return true;
+	}
+
+	std::uint64_t iterations() const { return m_iterations; }
+
+	double elapsedNs() const {
+		return std::chrono::duration<double, std::nano>(m_end - m_start).count();
+	}
+
+}; // end of class
+
+
+//! What a benchmark measured, all times are per iteration.
+struct BenchmarkResult
+{
+	std::string 	name;
+	std::uint64_t 	iterations;		//!< Per sample.
+	unsigned int 	samples;
+	double 			meanNs, medianNs, stddevNs, minNs;
+
+	PerfCounterValues 	counters;			//!< Per iteration, empty if unavailable.
+	std::string 		countersUnavailable;	//!< Why there are no counters.
+
+}; // end of struct
+
+
+namespace Details {
+
+inline void writeBenchmarkJson(std::string const & path, BenchmarkResult const & result)
+{
+	std::ofstream file(path.c_str(), std::ios::app);
+
+	file << "{\"name\":\"" << result.name << "\""
+		 << ",\"iterations\":" << result.iterations
+		 << ",\"samples\":" << result.samples
+		 << ",\"meanNs\":" << result.meanNs
+		 << ",\"medianNs\":" << result.medianNs
+		 << ",\"stddevNs\":" << result.stddevNs
+		 << ",\"minNs\":" << result.minNs;
+
+	for(int i = 0; i < PerfCounterValues::COUNT; ++i)
+	{
+		PerfCounterValues::Counter const counter = PerfCounterValues::Counter(i);
+
+		if(result.counters.has(counter)) {
+			file << ",\"" << PerfCounterValues::name(counter) << "\":" << result.counters.values[i];
+		}
+	}
+
+	if(result.counters.ipc() >= 0.0) {
+		file << ",\"ipc\":" << result.counters.ipc();
+	}
+
+	if(!result.countersUnavailable.empty()) {
+		file << ",\"countersUnavailable\":\"" << result.countersUnavailable << "\"";
+	}
+
+	file << "}\n";
+}
+
+} // end of namespace
+
+
+/*!
+ *	Base of BENCHMARK(), run() is the engine.
+ */
+struct Benchmark : public ITest
+{
+	static const unsigned int SAMPLES = 15;
+	static constexpr double TARGET_SAMPLE_NS = 5000000.0;
+
+	virtual void measure(BenchmarkState & state) const = 0;
+
+	bool isBenchmark() const { return true; }
+
+
+	//! One sample, ns per iteration.
+	double sample(std::uint64_t iterations, PerfCounters * counters = 0) const
+	{
+		BenchmarkState state(iterations, counters);
+		measure(state);
+
+		return state.elapsedNs() / double(iterations);
+	}
+
+
+	BenchmarkResult measureAll() const
+	{
+		// Grow the iterations until one sample is long enough to time.
+		std::uint64_t iterations(1);
+
+		for(;;)
+		{
+			double const totalNs = sample(iterations) * double(iterations);
+
+			if(totalNs >= TARGET_SAMPLE_NS || iterations >= 1000000000) {
+				break;
+			}
+
+			double const scale = (totalNs > 0.0) ? (TARGET_SAMPLE_NS * 1.2) / totalNs : 10.0;
+			iterations = std::uint64_t(double(iterations) * std::min(10.0, std::max(2.0, scale)));
+		}
+
+		// Warm up.
+		sample(iterations);
+
+		std::vector<double> samples(SAMPLES);
+		PerfCounters counters;
+
+		for(unsigned int i = 0; i < SAMPLES; ++i) {
+			samples[i] = sample(iterations, &counters);
+		}
+
+		double sum(0.0);
+
+		for(unsigned int i = 0; i < SAMPLES; ++i) {
+			sum += samples[i];
+		}
+
+		double const mean = sum / double(SAMPLES);
+		double squares(0.0);
+
+		for(unsigned int i = 0; i < SAMPLES; ++i) {
+			squares += (samples[i] - mean) * (samples[i] - mean);
+		}
+
+		std::sort(samples.begin(), samples.end());
+
+		BenchmarkResult result;
+		result.name 		= getName();
+		result.iterations 	= iterations;
+		result.samples 		= SAMPLES;
+		result.meanNs 		= mean;
+		result.medianNs 	= (samples[SAMPLES / 2] + samples[(SAMPLES - 1) / 2]) / 2.0;
+		result.stddevNs 	= sqrt(squares / double(SAMPLES - 1));
+		result.minNs 		= samples.front();
+
+		if(counters.available()) {
+			result.counters = counters.total().dividedBy(double(iterations) * double(SAMPLES));
+		} else {
+			result.countersUnavailable = counters.unavailableReason();
+		}
+
+		return result;
+	}
+
+
+	void run() const
+	{
+		BenchmarkResult const result = measureAll();
+
+		TestLogging() << "mean " << result.meanNs << " ns, median " << result.medianNs
+					  << " ns, stddev " << result.stddevNs << " ns, min " << result.minNs
+					  << " ns (" << result.samples << " x " << result.iterations << " iterations)";
+
+		if(result.countersUnavailable.empty()) {
+			TestLogging() << "per iteration " << Details::describeCounters(result.counters);
+		} else {
+			TestLogging() << "wall time only, " << result.countersUnavailable;
+		}
+
+		std::string const & json = UnitTest::instance().options().benchmarkJson;
+
+		if(!json.empty()) {
+			Details::writeBenchmarkJson(json, result);
+		}
+	}
+
+}; // end of struct
+
+
+} // end of namespace
+
+
+//! Creates a benchmark, the body gets a BenchmarkState called state.
+#define BENCHMARK(ClassName)											\
+struct Benchmark##ClassName : public Dead::Benchmark					\
+{																		\
+	std::string name; 													\
+	Benchmark##ClassName()												\
+	: name(#ClassName)													\
+	{																	\
+		Dead::UnitTest::instance().addTest(this);						\
+	}																	\
+																		\
+	std::string getName() const { return name; }						\
+																		\
+	void measure(Dead::BenchmarkState & state) const;					\
+} instanceBenchmark##ClassName;											\
+																		\
+void Benchmark##ClassName::measure(Dead::BenchmarkState & state) const	\
+
+
+#endif // end of include guard
@@ -0,0 +1,314 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Hardware performance counters (Linux perf_event_open) for benchmarks
+ *	and scoped regions of tests.
+ *	Counts cycles, instructions, cache misses and branch misses of the
+ *	calling thread, user space only.
+ *
+ *	{
+ *		Dead::PerfRegion region("Sort entities");
+ *		sortEntities();
+ *	}	// Logs wall time, counters and IPC through TestLogging.
+ *
+ *	Counters are often not allowed (containers, perf_event_paranoid, VMs
+ *	without a PMU), then available() is false, unavailableReason() says why
+ *	and everything falls back to wall time. Other platforms are always
+ *	unavailable for now.
+ */
+
+
+#ifndef DEAD_TEST_PERF_COUNTERS_INCLUDED
+#define DEAD_TEST_PERF_COUNTERS_INCLUDED
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <Dead/Config/Platform.hpp>
+#include <Dead/Test/UnitTest.hpp>
+
+#if defined(DEAD_ON_LINUX)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace Dead {
+
+
+//! Counter totals, missing counters are left at -1.
+struct PerfCounterValues
+{
+	enum Counter { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, COUNT };
+
+	double values[COUNT];
+
+	PerfCounterValues()
+	{
+		for(int i = 0; i < COUNT; ++i) {
+			values[i] = -1.0;
+		}
+	}
+
+	bool has(Counter counter) const { return values[counter] >= 0.0; }
+
+	double cycles() 		const { return values[CYCLES]; }
+	double instructions() 	const { return values[INSTRUCTIONS]; }
+	double cacheMisses() 	const { return values[CACHE_MISSES]; }
+	double branchMisses() 	const { return values[BRANCH_MISSES]; }
+
+	//! Instructions per cycle, -1 if either is missing.
+	double ipc() const {
+		return (has(CYCLES) && has(INSTRUCTIONS) && cycles() > 0.0) ? instructions() / cycles() : -1.0;
+	}
+
+	//! Every counter divided by n, eg to get per iteration figures.
+	PerfCounterValues dividedBy(double n) const
+	{
+		PerfCounterValues result;
+
+		for(int i = 0; i < COUNT; ++i) {
+			result.values[i] = has(Counter(i)) ? values[i] / n : -1.0;
+		}
+
+		return result;
+	}
+
+	static char const * name(Counter counter)
+	{
+		static char const * const names[] = { "cycles", "instructions", "cacheMisses", "branchMisses" };
+		return names[counter];
+	}
+
+}; // end of struct
+
+
+/*!
+ *	A group of counters on the calling thread. start() / stop() pairs add to
+ *	total(), the counters only run between them.
+ */
+class PerfCounters
+{
+	int 				m_fds[PerfCounterValues::COUNT];
+	int 				m_leader;
+	std::string 		m_unavailable;
+	PerfCounterValues 	m_total;
+
+	#if defined(DEAD_ON_LINUX)
+
+	static int openCounter(std::uint64_t config, int group)
+	{
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+
+		attr.size 			= sizeof(attr);
+		attr.type 			= PERF_TYPE_HARDWARE;
+		attr.config 		= config;
+		attr.disabled 		= (group == -1) ? 1 : 0;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv 	= 1;
+		attr.read_format 	= PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		return int(syscall(__NR_perf_event_open, &attr, 0, -1, group, 0));
+	}
+
+	#endif
+
+public:
+
+	PerfCounters()
+		: m_leader(-1)
+		, m_unavailable()
+		, m_total()
+	{
+		for(int i = 0; i < PerfCounterValues::COUNT; ++i) {
+			m_fds[i] = -1;
+		}
+
+		#if defined(DEAD_ON_LINUX)
+
+		static std::uint64_t const configs[] = {
+			PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+			PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+		};
+
+		m_leader = openCounter(configs[0], -1);
+
+		if(m_leader < 0)
+		{
+			m_unavailable = std::string("perf_event_open failed: ") + std::strerror(errno);
+			return;
+		}
+
+		m_fds[0] = m_leader;
+
+		// The rest are optional, some PMUs don't have them.
+		for(int i = 1; i < PerfCounterValues::COUNT; ++i) {
+			m_fds[i] = openCounter(configs[i], m_leader);
+		}
+
+		#else
+
+		m_unavailable = "hardware counters are only supported on Linux";
+
+		#endif
+	}
+
+	~PerfCounters()
+	{
+		#if defined(DEAD_ON_LINUX)
+		for(int i = 0; i < PerfCounterValues::COUNT; ++i)
+		{
+			if(m_fds[i] >= 0) {
+				close(m_fds[i]);
+			}
+		}
+		#endif
+	}
+
+	PerfCounters(PerfCounters const &) = delete;
+	PerfCounters & operator=(PerfCounters const &) = delete;
+
+
+	bool available() const { return m_leader >= 0; }
+
+	std::string const & unavailableReason() const { return m_unavailable; }
+
+
+	void start()
+	{
+		#if defined(DEAD_ON_LINUX)
+		if(available())
+		{
+			ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		}
+		#endif
+	}
+
+
+	void stop()
+	{
+		#if defined(DEAD_ON_LINUX)
+		if(!available()) {
+			return;
+		}
+
+		ioctl(m_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+		// nr, time enabled, time running, then one value per open counter.
+		std::uint64_t data[3 + PerfCounterValues::COUNT];
+
+		if(read(m_leader, data, sizeof(data)) < ssize_t(3 * sizeof(std::uint64_t))) {
+			return;
+		}
+
+		// Scale up if the PMU had to multiplex the group.
+		double const scale = (data[2] > 0) ? double(data[1]) / double(data[2]) : 1.0;
+		std::uint64_t index(3);
+
+		for(int i = 0; i < PerfCounterValues::COUNT && index < 3 + data[0]; ++i)
+		{
+			if(m_fds[i] < 0) {
+				continue;
+			}
+
+			double const value = double(data[index++]) * scale;
+			m_total.values[i] = (m_total.values[i] < 0.0) ? value : m_total.values[i] + value;
+		}
+		#endif
+	}
+
+
+	PerfCounterValues const & total() const { return m_total; }
+
+	void reset() { m_total = PerfCounterValues(); }
+
+}; // end of class
+
+
+namespace Details {
+
+//! "cycles 12.5, instructions 40, IPC 3.2, ..." for the counters there are.
+inline std::string describeCounters(PerfCounterValues const & values)
+{
+	std::ostringstream text;
+
+	for(int i = 0; i < PerfCounterValues::COUNT; ++i)
+	{
+		PerfCounterValues::Counter const counter = PerfCounterValues::Counter(i);
+
+		if(values.has(counter)) {
+			text << (i ? ", " : "") << PerfCounterValues::name(counter) << " " << values.values[i];
+		}
+
+		if(counter == PerfCounterValues::INSTRUCTIONS && values.ipc() >= 0.0) {
+			text << ", IPC " << values.ipc();
+		}
+	}
+
+	return text.str();
+}
+
+} // end of namespace
+
+
+/*!
+ *	Counts a scope and logs it through TestLogging when it ends.
+ */
+class PerfRegion
+{
+	typedef std::chrono::steady_clock Clock;
+
+	char const 			*m_name;
+	PerfCounters 		m_counters;
+	Clock::time_point 	m_start;
+
+public:
+
+	explicit PerfRegion(char const * name)
+		: m_name(name)
+		, m_counters()
+		, m_start()
+	{
+		m_counters.start();
+		m_start = Clock::now();
+	}
+
+	~PerfRegion()
+	{
+		Clock::time_point const end = Clock::now();
+		m_counters.stop();
+
+		double const ns = std::chrono::duration<double, std::nano>(end - m_start).count();
+
+		if(m_counters.available()) {
+			TestLogging() << m_name << ": " << ns << " ns, " << Details::describeCounters(m_counters.total());
+		} else {
+			TestLogging() << m_name << ": " << ns << " ns (wall time only, " << m_counters.unavailableReason() << ")";
+		}
+	}
+
+	PerfRegion(PerfRegion const &) = delete;
+	PerfRegion & operator=(PerfRegion const &) = delete;
+
+}; // end of class
+
+
+} // end of namespace
+
+
+#endif // end of include guard
@@ -0,0 +1,268 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Asserts that keep hot paths fast.
+ *
+ *	ASSERT_NO_ALLOCATIONS {
+ *		eventMgr.fireQueuedEvents();
+ *	}
+ *
+ *	ASSERT_MAX_ALLOCATIONS(2) {
+ *		eventMgr.addController(controller, GAME_START_MSG);
+ *	}
+ *
+ *	ASSERT_FASTER_THAN(100, 10000, eventMgr.fireInstantEvent(data, GAME_START_MSG));
+ *
+ *	Allocations are counted by replacing the global operator new / delete.
+ *	That can only happen once per program, so exactly one file of the test
+ *	executable has to
+ *
+ *	#define DEAD_TEST_ALLOCATION_HOOKS
+ *	#include <Dead/Test/Performance.hpp>
+ *
+ *	Allocation asserts fail if the hooks aren't in. Only allocations made on
+ *	the calling thread are counted, so parallel tests don't see each other's.
+ *	Over aligned new (C++17) isn't hooked, so isn't counted.
+ *	ASSERT_FASTER_THAN takes the best average of three batches of iterations.
+ *	It keeps expr's value (DoNotOptimize) and clobbers memory after each
+ *	call, so the compiler can't drop or hoist it, but inputs that never
+ *	change can still be folded, read them from memory.
+ */
+
+
+#ifndef DEAD_TEST_PERFORMANCE_INCLUDED
+#define DEAD_TEST_PERFORMANCE_INCLUDED
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <Dead/Config/Compiler.hpp>
+#include <Dead/Test/Benchmark.hpp>
+#include <Dead/Test/UnitTest.hpp>
+
+
+namespace Dead {
+
+
+namespace Details {
+
+
+struct AllocationCounts
+{
+	std::uint64_t allocations, bytes;
+};
+
+
+//! Counts for the calling thread, the operator new hook adds to these.
+inline AllocationCounts & threadAllocationCounts()
+{
+	static thread_local AllocationCounts counts = { 0, 0 };
+	return counts;
+}
+
+
+inline bool & allocationHooksInstalled()
+{
+	static bool installed(false);
+	return installed;
+}
+
+
+//! Average ns per call of the best of three batches.
+template<typename Function>
+double nsPerIteration(std::uint64_t iterations, Function function)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	// Warm up.
+	function();
+
+	double best(0.0);
+
+	for(int batch = 0; batch < 3; ++batch)
+	{
+		Clock::time_point const start = Clock::now();
+
+		for(std::uint64_t i = 0; i < iterations; ++i)
+		{
+			function();
+			Dead::ClobberMemory();
+		}
+
+		double const ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / double(iterations);
+		best = (batch == 0) ? ns : std::min(best, ns);
+	}
+
+	return best;
+}
+
+
+//! (expr, KeepValue()) hands expr's value to DoNotOptimize(), a void expr
+//! uses the built in comma and is left alone.
+struct KeepValue {};
+
+template<typename T>
+KeepValue operator,(T const & value, KeepValue)
+{
+	Dead::DoNotOptimize(value);
+	return KeepValue();
+}
+
+
+template<typename Function>
+void assertFasterThan(double maxNs, std::uint64_t iterations, Function function, char const * expression)
+{
+	double const ns = nsPerIteration(iterations, function);
+
+	if(ns < maxNs) {
+		Dead::UnitTest::instance().passedCurrentTest();
+	} else {
+		Dead::UnitTest::instance().failedCurrentTest();
+		Dead::TestLogging() << "Failed! ASSERT_FASTER_THAN, " << expression << " took " << ns << " ns, limit " << maxNs << " ns.";
+	}
+}
+
+
+} // end of namespace
+
+
+/*!
+ *	Counts allocations on this thread from construction.
+ *	Also drives the ASSERT_*_ALLOCATIONS macros, once() lets the block run
+ *	a single time and check() reports after it.
+ */
+class AllocationScope
+{
+	Details::AllocationCounts 	m_start;
+	std::uint64_t 				m_max;
+	char const 					*m_assert;
+	bool 						m_done;
+
+public:
+
+	explicit AllocationScope(std::uint64_t max = 0, char const * assertName = "")
+		: m_start(Details::threadAllocationCounts())
+		, m_max(max)
+		, m_assert(assertName)
+		, m_done(false)
+	{}
+
+	std::uint64_t allocations() const { return Details::threadAllocationCounts().allocations - m_start.allocations; }
+	std::uint64_t bytes() 		const { return Details::threadAllocationCounts().bytes - m_start.bytes; }
+
+	bool once() const { return !m_done; }
+
+	void check()
+	{
+		std::uint64_t const count = allocations();
+		std::uint64_t const size  = bytes();
+
+		m_done = true;
+
+		if(!Details::allocationHooksInstalled())
+		{
+			Dead::UnitTest::instance().failedCurrentTest();
+			Dead::TestLogging() << "Failed! " << m_assert << ", define DEAD_TEST_ALLOCATION_HOOKS in one file to count allocations.";
+		}
+		else if(count <= m_max)
+		{
+			Dead::UnitTest::instance().passedCurrentTest();
+		}
+		else
+		{
+			Dead::UnitTest::instance().failedCurrentTest();
+			Dead::TestLogging() << "Failed! " << m_assert << ", with " << count << " allocation(s) (" << size << " bytes), max " << m_max << ".";
+		}
+	}
+
+}; // end of class
+
+
+} // end of namespace
+
+
+
+// *** ALLOCATION HOOKS **** //
+
+#if defined(DEAD_TEST_ALLOCATION_HOOKS)
+
+namespace Dead { namespace Details {
+
+inline void * countedAllocate(std::size_t size)
+{
+	AllocationCounts &counts = threadAllocationCounts();
+	counts.allocations++;
+	counts.bytes += size;
+
+	return std::malloc(size ? size : 1);
+}
+
+static bool const allocationHooks = (allocationHooksInstalled() = true);
+
+} } // end of namespace
+
+
+// Kept out of line, once GCC inlines them it warns about free() on memory
+// from operator new.
+DEAD_NOINLINE void * operator new(std::size_t size)
+{
+	if(void *memory = Dead::Details::countedAllocate(size)) {
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+DEAD_NOINLINE void * operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+DEAD_NOINLINE void * operator new(std::size_t size, std::nothrow_t const &) noexcept {
+	return Dead::Details::countedAllocate(size);
+}
+
+DEAD_NOINLINE void * operator new[](std::size_t size, std::nothrow_t const &) noexcept {
+	return Dead::Details::countedAllocate(size);
+}
+
+DEAD_NOINLINE void operator delete(void * memory) noexcept 							{ std::free(memory); }
+DEAD_NOINLINE void operator delete[](void * memory) noexcept 							{ std::free(memory); }
+DEAD_NOINLINE void operator delete(void * memory, std::nothrow_t const &) noexcept 	{ std::free(memory); }
+DEAD_NOINLINE void operator delete[](void * memory, std::nothrow_t const &) noexcept 	{ std::free(memory); }
+
+#if defined(__cpp_sized_deallocation)
+DEAD_NOINLINE void operator delete(void * memory, std::size_t) noexcept 				{ std::free(memory); }
+DEAD_NOINLINE void operator delete[](void * memory, std::size_t) noexcept 			{ std::free(memory); }
+#endif
+
+#endif // DEAD_TEST_ALLOCATION_HOOKS
+
+
+
+//! The block that follows may allocate at most n times (on this thread).
+#define ASSERT_MAX_ALLOCATIONS(n)																		\
+for(Dead::AllocationScope deadAllocationScope(n, "ASSERT_MAX_ALLOCATIONS"); deadAllocationScope.once(); deadAllocationScope.check())
+
+
+//! The block that follows mustn't allocate (on this thread).
+#define ASSERT_NO_ALLOCATIONS																			\
+for(Dead::AllocationScope deadAllocationScope(0, "ASSERT_NO_ALLOCATIONS"); deadAllocationScope.once(); deadAllocationScope.check())
+
+
+//! expr must average under ns nanoseconds over iterations runs.
+#define ASSERT_FASTER_THAN(ns, iterations, expr)														\
+Dead::Details::assertFasterThan(ns, iterations, [&]() { ((expr), Dead::Details::KeepValue()); }, #expr);	\
+
+
+#endif // end of include guard
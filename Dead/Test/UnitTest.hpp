@@ -18,6 +18,7 @@
  *	- Issue with ASSERT_IS_NEAR() with floats. ie (1.0, 1.2, 0.2) doesn't
  *	  pass as true, when it should.
  *	- TestLogging is werid, would prefer this a template member of the UnitTest class.
+ *	- Asserts made on threads a test spawns count towards the run, not the test.
  *	- Should make it a fully singleton hide asignment etc.
  *	- Add Greater and Less then checks.
  */
@@ -27,11 +28,24 @@
 #define DEAD_UNIT_TEST_INCLUDED
 
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
 #include <list>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 #include <math.h>
+#include <Dead/Config/Threads.hpp>
 #include <Dead/Log/Logger.hpp>
 #include <Dead/Log/LoggerPolicies.hpp>
+#include <Dead/Trace.hpp>
 
 
 namespace Dead {
@@ -44,11 +58,190 @@ struct ITest
 {
 	virtual std::string getName() const = 0;
 	virtual void run() const = 0;
+
+	//! Benchmarks share the registry but only run when asked for.
+	virtual bool isBenchmark() const { return false; }
+}; // end of struct
+
+
+/*!
+ *	What happened in one test. Each runner thread fills in its own, so the
+ *	asserts never share counters.
+ */
+struct TestResult
+{
+	unsigned int 		passed, failed;
+	double 				milliseconds;
+	std::ostringstream 	output;
+
+	TestResult()
+		: passed(0)
+		, failed(0)
+		, milliseconds(0.0)
+		, output()
+	{}
 }; // end of struct
 
 
+namespace Details {
+
+//! The result the asserts on this thread report into, null outside a test run.
+inline TestResult *& currentTestResult()
+{
+	static thread_local TestResult *result = 0;
+	return result;
+}
+
+} // end of namespace
+
+
+//! Writes into the running test's output so parallel tests don't interleave,
+//! straight to the console when no test is running.
+class TestOutput
+{
+public:
+
+	~TestOutput() {
+		out("\n");
+	}
+
+	template<typename T>
+	void out(T const & output)
+	{
+		if(TestResult *result = Details::currentTestResult()) {
+			result->output << output;
+		} else {
+			std::cout << output;
+		}
+	}
+}; // class TestOutput
+
+
 //! Outputting test information.
-typedef Logger<ConsoleOutput>	TestLogging;
+typedef Logger<TestOutput>	TestLogging;
+
+
+/*!
+ *	How runTests() should run.
+ *	filter is a comma separated list of names, '*' and '?' are wildcards and
+ *	a leading '-' excludes. Tests run if they match any include (or there are
+ *	none) and no exclude.
+ *	Tests that share globals need to keep jobs at 1.
+ */
+struct TestOptions
+{
+	unsigned int 	jobs;			//!< Threads to run tests on, 0 for one per core.
+	std::string 	filter;
+	unsigned int 	shardIndex;		//!< Run only every shardCount'th test, starting at shardIndex.
+	unsigned int 	shardCount;
+	bool 			benchmarks;		//!< Run BENCHMARK()s too, always one at a time after the tests.
+	std::string 	benchmarkJson;	//!< File to write benchmark results to, one JSON object per line.
+
+	TestOptions()
+		: jobs(1)
+		, filter()
+		, shardIndex(0)
+		, shardCount(1)
+		, benchmarks(false)
+		, benchmarkJson()
+	{}
+}; // end of struct
+
+
+namespace Details {
+
+inline bool wildcardMatch(char const * pattern, char const * name)
+{
+	if(*pattern == '*') {
+		return wildcardMatch(pattern + 1, name) || (*name && wildcardMatch(pattern, name + 1));
+	}
+
+	if(*name && (*pattern == '?' || *pattern == *name)) {
+		return wildcardMatch(pattern + 1, name + 1);
+	}
+
+	return !*pattern && !*name;
+}
+
+
+inline bool matchesFilter(std::string const & filter, std::string const & name)
+{
+	bool hasInclude(false), included(false);
+
+	std::istringstream patterns(filter);
+	std::string pattern;
+
+	while(std::getline(patterns, pattern, ','))
+	{
+		if(pattern.empty()) {
+			continue;
+		}
+
+		if(pattern[0] == '-')
+		{
+			if(wildcardMatch(pattern.c_str() + 1, name.c_str())) {
+				return false;
+			}
+		}
+		else
+		{
+			hasInclude = true;
+			included = included || wildcardMatch(pattern.c_str(), name.c_str());
+		}
+	}
+
+	return !hasInclude || included;
+}
+
+} // end of namespace
+
+
+//! Reads --jobs=N, --filter=a,b, --shard=i/n, --benchmarks and --benchmark-json=file.
+//! Returns false (after printing the usage) on anything else.
+inline bool parseTestOptions(int argc, char **argv, TestOptions & options)
+{
+	for(int i = 1; i < argc; ++i)
+	{
+		char const *arg = argv[i];
+
+		if(std::strncmp(arg, "--jobs=", 7) == 0) {
+			options.jobs = unsigned(std::atoi(arg + 7));
+		}
+		else if(std::strncmp(arg, "--filter=", 9) == 0) {
+			options.filter = arg + 9;
+		}
+		else if(std::strncmp(arg, "--shard=", 8) == 0)
+		{
+			char const *slash = std::strchr(arg + 8, '/');
+			int const index = std::atoi(arg + 8);
+			int const count = slash ? std::atoi(slash + 1) : 0;
+
+			if(count < 1 || index < 0 || index >= count)
+			{
+				std::cerr << "Bad shard " << (arg + 8) << ", expected i/n with 0 <= i < n." << std::endl;
+				return false;
+			}
+
+			options.shardIndex = unsigned(index);
+			options.shardCount = unsigned(count);
+		}
+		else if(std::strcmp(arg, "--benchmarks") == 0) {
+			options.benchmarks = true;
+		}
+		else if(std::strncmp(arg, "--benchmark-json=", 17) == 0) {
+			options.benchmarks = true;
+			options.benchmarkJson = arg + 17;
+		}
+		else
+		{
+			std::cerr << "Usage: " << argv[0] << " [--jobs=N] [--filter=Name,Prefix*,-Excluded] [--shard=i/n]"
+					  << " [--benchmarks] [--benchmark-json=file]" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
 
 
 /*!
@@ -65,13 +258,36 @@ class UnitTest
 	//! Some stats on how things have done.
 	unsigned int m_passed, m_failed;
 
+	//! Counts asserts made on threads with no test of their own, eg ones a
+	//! test spawned. Added to the totals at the end of the run.
+	std::atomic<unsigned int> m_loosePassed, m_looseFailed;
+
+	//! Options for the current run.
+	TestOptions m_options;
+
 	//! Private ctor.
 	explicit UnitTest()
-		: m_passed(0)
+		: m_tests()
+		, m_passed(0)
 		, m_failed(0)
-		, m_tests()
+		, m_loosePassed(0)
+		, m_looseFailed(0)
+		, m_options()
 	{}
 
+
+	static void reportTest(ITest const & test, TestResult const & result)
+	{
+		TestLogging() << "\n" << test.getName() << " (" << result.milliseconds << " ms)";
+		std::cout << result.output.str();
+
+		if(result.failed == 0) {
+			TestLogging() << "All test(s) passed!";
+		} else {
+			TestLogging() << result.failed << " Test(s) failed!";
+		}
+	}
+
 public:
 
 	//! Singlton access.
@@ -82,62 +298,219 @@ public:
 	}
 
 
+	//! Runs one test on the calling thread, timing it. Its asserts go into
+	//! result, even when called from inside another test.
+	static void runTest(ITest const & test, TestResult & result)
+	{
+		TestResult * const outer = Details::currentTestResult();
+		Details::currentTestResult() = &result;
+
+		{
+			DEAD_TRACE_SCOPE_STRING(test.getName());
+
+			std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+			test.run();
+			std::chrono::steady_clock::time_point const end = std::chrono::steady_clock::now();
+
+			result.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+		}
+
+		Details::currentTestResult() = outer;
+	}
+
+
 	//! This adds a test to the list.
 	void addTest(ITest * newTest) {
 		m_tests.push_back(newTest);	
 	}
 
 
-	//! Runs all the tests.
-	void runTests()
+	//! Runs all the tests, one after another.
+	void runTests() {
+		runTests(TestOptions());
+	}
+
+
+	//! Runs the tests picked by options, on options.jobs threads.
+	//! Returns the number of failed asserts.
+	unsigned int runTests(TestOptions const & options)
 	{
+		m_options = options;
+
+		// Pick the tests, sharding after filtering so shards stay even.
+		// Benchmarks go last, so they can run on their own.
+		std::vector<ITest*> selected, benchmarks;
+		unsigned int index(0);
+
+		for(TestListIt testIt = m_tests.begin(); testIt != m_tests.end(); ++testIt)
+		{
+			if((*testIt)->isBenchmark() && !options.benchmarks) {
+				continue;
+			}
+
+			if(!Details::matchesFilter(options.filter, (*testIt)->getName())) {
+				continue;
+			}
+
+			if((index++ % options.shardCount) == options.shardIndex) {
+				((*testIt)->isBenchmark() ? benchmarks : selected).push_back(*testIt);
+			}
+		}
+
+		std::size_t const testCount = selected.size();
+		selected.insert(selected.end(), benchmarks.begin(), benchmarks.end());
+
+		if(!benchmarks.empty() && !options.benchmarkJson.empty()) {
+			std::ofstream(options.benchmarkJson.c_str(), std::ios::trunc);
+		}
+
+
 		// Title screen.
 		TestLogging() << "\n" << "Running Unit Tests";
 		TestLogging() << "==================";
 
 
-		// Run the individual tests.
-		TestListIt testIt = m_tests.begin();
+		// Run the individual tests, each worker takes the next test and
+		// reports it as soon as it's done.
+		std::vector<TestResult> results(selected.size());
+		std::atomic<std::size_t> next(0);
+		std::mutex reportMutex;
 
-		for(testIt; testIt != m_tests.end(); ++testIt)
+		auto worker = [&]()
 		{
-			unsigned int fails(m_failed);
+			for(std::size_t i = next.fetch_add(1); i < testCount; i = next.fetch_add(1))
+			{
+				runTest(*selected[i], results[i]);
 
-			TestLogging() << "\n" << (*testIt)->getName();
-			(*testIt)->run();
+				std::lock_guard<std::mutex> lock(reportMutex);
+				reportTest(*selected[i], results[i]);
+			}
+		};
+
+		#if defined(DEAD_HAS_THREADS)
+		unsigned int jobs = options.jobs ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+		jobs = unsigned(std::min<std::size_t>(jobs, testCount));
+		#else
+		unsigned int const jobs(1);
+		#endif
 
-			if(fails == m_failed) {
-				TestLogging() << "All test(s) passed!";
-			} else {
-				TestLogging() << (m_failed - fails) << " Test(s) failed!";
+		std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+		#if defined(DEAD_HAS_THREADS)
+		if(jobs > 1)
+		{
+			std::vector<std::thread> threads;
+
+			for(unsigned int i = 0; i < jobs; ++i) {
+				threads.push_back(std::thread(worker));
+			}
+
+			for(unsigned int i = 0; i < jobs; ++i) {
+				threads[i].join();
 			}
 		}
+		else
+		#endif
+		{
+			worker();
+		}
+
+		for(std::size_t i = testCount; i < selected.size(); ++i)
+		{
+			runTest(*selected[i], results[i]);
+			reportTest(*selected[i], results[i]);
+		}
+
+		std::chrono::steady_clock::time_point const end = std::chrono::steady_clock::now();
+
+		unsigned int failed(m_looseFailed.exchange(0));
+		m_passed += m_loosePassed.exchange(0);
+
+		if(failed > 0) {
+			TestLogging() << "\n" << failed << " Test(s) failed outside a test's own thread!";
+		}
+
+		for(std::size_t i = 0; i < results.size(); ++i)
+		{
+			m_passed += results[i].passed;
+			failed 	 += results[i].failed;
+		}
+
+		m_failed += failed;
 
 
 		// End screen.
 		TestLogging() << "\n" << "Results" << "\n" << "-------";
+
+		if(options.shardCount > 1) {
+			TestLogging() << "Shard: " << options.shardIndex << "/" << options.shardCount;
+		}
+
+		TestLogging() << "Tests Run: " << selected.size() << " of " << m_tests.size()
+					  << " on " << std::max(1u, jobs) << " thread(s) in "
+					  << std::chrono::duration<double, std::milli>(end - start).count() << " ms";
 		TestLogging() << "Tests Passed: " << m_passed;
 		TestLogging() << "Tests Failed: " << m_failed;
+
+		return failed;
 	}
 
 
 
+	//! Options for the run in progress.
+	TestOptions const & options() const { return m_options; }
+
+
+	//! Asserts counted so far this run on threads with no test of their own.
+	unsigned int loosePassed() const { return m_loosePassed.load(); }
+	unsigned int looseFailed() const { return m_looseFailed.load(); }
+
+
 	//! Increase the passed tests.
-	void passedCurrentTest() { m_passed++; }
+	void passedCurrentTest()
+	{
+		if(TestResult *result = Details::currentTestResult()) {
+			result->passed++;
+		} else {
+			m_loosePassed++;
+		}
+	}
+
 	//! Increase the failed tests.
-	void failedCurrentTest() { m_failed++; }
+	void failedCurrentTest()
+	{
+		if(TestResult *result = Details::currentTestResult()) {
+			result->failed++;
+		} else {
+			m_looseFailed++;
+		}
+	}
 
 
 }; // end of class
 
 
 // Run the tests
-void RunTests()
+inline void RunTests()
 {
 	Dead::UnitTest::instance().runTests();
 }
 
 
+// Run the tests picked by the command line (see parseTestOptions()),
+// returns an exit code for main().
+inline int RunTests(int argc, char **argv)
+{
+	TestOptions options;
+
+	if(!parseTestOptions(argc, argv, options)) {
+		return 2;
+	}
+
+	return (Dead::UnitTest::instance().runTests(options) == 0) ? 0 : 1;
+}
+
+
 } // end of namespace
 
 
@@ -0,0 +1,60 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Frame tracing. Define DEAD_TRACE_ENABLED (for the whole build) to turn
+ *	it on, otherwise these macros compile to nothing.
+ *
+ *	void Physics::step()
+ *	{
+ *		DEAD_TRACE_SCOPE("Physics::step");
+ *		...
+ *	}
+ *
+ *	DEAD_TRACE_FLUSH("frame.json");		// Open in ui.perfetto.dev
+ *
+ *	DEAD_TRACE_SCOPE takes a string that outlives the trace (a literal),
+ *	DEAD_TRACE_SCOPE_STRING takes a std::string and keeps a copy of it.
+ *	A zone costs two tick clock reads and a write into a thread local ring.
+ *	The event manager traces fireQueuedEvents and each receiveEvent call,
+ *	UnitTest traces each test.
+ */
+
+
+#ifndef DEAD_TRACE_INCLUDED
+#define DEAD_TRACE_INCLUDED
+
+
+#if defined(DEAD_TRACE_ENABLED)
+
+#include <Dead/Trace/Tracer.hpp>
+
+#define DEAD_TRACE_CONCAT_DETAIL(a, b) a##b
+#define DEAD_TRACE_CONCAT(a, b) DEAD_TRACE_CONCAT_DETAIL(a, b)
+
+#define DEAD_TRACE_SCOPE(name) \
+Dead::TraceScope DEAD_TRACE_CONCAT(deadTraceScope, __LINE__)(name)
+
+#define DEAD_TRACE_SCOPE_STRING(name) \
+Dead::TraceScope DEAD_TRACE_CONCAT(deadTraceScope, __LINE__)(Dead::Tracer::instance().intern(name))
+
+#define DEAD_TRACE_FLUSH(path) \
+Dead::Tracer::instance().flush(path)
+
+#else
+
+#define DEAD_TRACE_SCOPE(name) 			static_cast<void>(0)
+#define DEAD_TRACE_SCOPE_STRING(name) 	static_cast<void>(0)
+#define DEAD_TRACE_FLUSH(path) 			static_cast<void>(0)
+
+#endif
+
+
+#endif // #ifndef DEAD_TRACE_INCLUDED
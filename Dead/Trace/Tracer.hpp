@@ -0,0 +1,335 @@
+// Copyright DeadEnd Games.
+// License: MIT
+
+/*!
+ *	History
+ *  October 2026, added/created file
+ */
+
+
+/*!
+ * 	About
+ *	Collects trace zones from every thread and writes them out as Chrome
+ *	trace JSON (open in Perfetto or chrome://tracing).
+ *	Use the macros in Dead/Trace.hpp rather than this directly, they
+ *	compile out when tracing is off.
+ *
+ *	Each thread writes into its own ring of DEAD_TRACE_BUFFER_EVENTS zones,
+ *	no locks, oldest zones get overwritten if nobody flushes. A flush only
+ *	writes the zones since the last flush. Flushing while other threads
+ *	are tracing can tear the oldest few zones of a full ring, flush at the
+ *	end of a frame. Once a thread has exited and its ring been flushed the
+ *	ring goes to the next new thread, rather than being kept for good.
+ */
+
+
+#ifndef DEAD_TRACE_TRACER_INCLUDED
+#define DEAD_TRACE_TRACER_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+#include <Dead/Log/Clock.hpp>
+
+
+#if !defined(DEAD_TRACE_BUFFER_EVENTS)
+#define DEAD_TRACE_BUFFER_EVENTS 16384
+#endif
+
+
+namespace Dead {
+
+
+//! One finished zone, name has to outlive the trace (literals, or Tracer::intern()).
+struct TraceEvent
+{
+	char const 		*name;
+	std::uint64_t 	begin;
+	std::uint64_t 	end;
+
+}; // struct TraceEvent
+
+
+/*!
+ *	Ring of zones owned by one thread.
+ */
+class TraceBuffer
+{
+	static_assert((DEAD_TRACE_BUFFER_EVENTS & (DEAD_TRACE_BUFFER_EVENTS - 1)) == 0, "DEAD_TRACE_BUFFER_EVENTS must be a power of two.");
+
+	enum { MASK = DEAD_TRACE_BUFFER_EVENTS - 1 };
+
+	std::uint32_t 				m_thread;
+	std::atomic<std::uint64_t> 	m_written;
+	std::uint64_t 				m_flushed;
+	std::atomic<bool> 			m_exited;
+	std::vector<TraceEvent> 	m_events;
+
+public:
+
+	explicit TraceBuffer(std::uint32_t thread)
+		: m_thread(thread)
+		, m_written(0)
+		, m_flushed(0)
+		, m_exited(false)
+		, m_events(DEAD_TRACE_BUFFER_EVENTS)
+	{}
+
+	//! Owning thread only.
+	void add(char const * name, std::uint64_t begin, std::uint64_t end)
+	{
+		std::uint64_t const index = m_written.load(std::memory_order_relaxed);
+
+		TraceEvent &event = m_events[index & MASK];
+		event.name 	= name;
+		event.begin = begin;
+		event.end 	= end;
+
+		m_written.store(index + 1, std::memory_order_release);
+	}
+
+	//! Hands every zone since the last drain to function, oldest first.
+	template<typename Function>
+	void drain(Function function)
+	{
+		std::uint64_t const written = m_written.load(std::memory_order_acquire);
+		std::uint64_t index = (written > DEAD_TRACE_BUFFER_EVENTS) ? written - DEAD_TRACE_BUFFER_EVENTS : 0;
+
+		for(index = (index > m_flushed) ? index : m_flushed; index < written; ++index) {
+			function(m_thread, m_events[index & MASK]);
+		}
+
+		m_flushed = written;
+	}
+
+	//! The owning thread has finished, once drained the buffer can be reused.
+	void threadExited() { m_exited.store(true, std::memory_order_release); }
+
+	bool drainedAndExited() const {
+		return m_exited.load(std::memory_order_acquire) && m_flushed == m_written.load(std::memory_order_acquire);
+	}
+
+	//! Hands a drained buffer to a new thread.
+	void reuse(std::uint32_t thread)
+	{
+		m_thread = thread;
+		m_written.store(0, std::memory_order_relaxed);
+		m_flushed = 0;
+		m_exited.store(false, std::memory_order_relaxed);
+	}
+
+}; // class TraceBuffer
+
+
+/*!
+ *	The threads' buffers. DEAD_TRACE_SCOPE goes to the one from instance(),
+ *	make your own to trace into buffers you hand out yourself.
+ */
+class Tracer
+{
+	std::mutex 									m_mutex;
+	std::vector<std::unique_ptr<TraceBuffer> > 	m_buffers;
+	std::set<std::string> 						m_names;
+
+	//! Tells the buffer when its thread exits.
+	struct ThreadBuffer
+	{
+		TraceBuffer *buffer;
+
+		~ThreadBuffer() {
+			buffer->threadExited();
+		}
+	};
+
+	static void writeEscaped(std::ostream & out, char const * text)
+	{
+		for(; *text; ++text)
+		{
+			if(*text == '"' || *text == '\\') {
+				out << '\\';
+			}
+
+			out << ((unsigned char)(*text) < 0x20 ? ' ' : *text);
+		}
+	}
+
+	//! Writes buffers [first, last) out, the caller holds m_mutex.
+	template<typename Iterator>
+	void writeChromeTrace(std::ostream & out, Iterator first, Iterator last, TickCalibration const & calibration)
+	{
+		double const usPerTick = calibration.nsPerTick / 1000.0;
+
+		std::ios::fmtflags const flags = out.flags();
+		out.setf(std::ios::fixed);
+		out.precision(3);
+
+		out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+		bool leading(true);
+
+		for(; first != last; ++first)
+		{
+			(*first)->drain([&](std::uint32_t thread, TraceEvent const & event)
+			{
+				out << (leading ? "\n" : ",\n") << "{\"name\":\"";
+				writeEscaped(out, event.name);
+				out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+					<< ",\"ts\":" << double(std::int64_t(event.begin - calibration.ticks)) * usPerTick
+					<< ",\"dur\":" << double(event.end - event.begin) * usPerTick << "}";
+
+				leading = false;
+			});
+		}
+
+		out << "\n]}\n";
+		out.flags(flags);
+	}
+
+public:
+
+	explicit Tracer()
+		: m_mutex()
+		, m_buffers()
+		, m_names()
+	{}
+
+	Tracer(Tracer const &) = delete;
+	Tracer & operator=(Tracer const &) = delete;
+
+
+	//! Singleton access, where DEAD_TRACE_SCOPE traces to.
+	static Tracer & instance()
+	{
+		static Tracer tracer;
+		return tracer;
+	}
+
+
+	//! The calling thread's buffer in instance(), made (or reused) on first
+	//! use. Its zones can still be flushed after the thread ends.
+	static TraceBuffer & threadBuffer()
+	{
+		static thread_local ThreadBuffer thread = { &instance().addBuffer(currentThreadId()) };
+		return *thread.buffer;
+	}
+
+
+	//! A buffer for thread, reusing one that has been drained since its
+	//! thread exited. Also calibrates TickClock, so zones never start
+	//! before the calibration and the spin doesn't land in a flush.
+	TraceBuffer & addBuffer(std::uint32_t thread)
+	{
+		TickClock::calibrate();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for(std::size_t i = 0; i < m_buffers.size(); ++i)
+		{
+			if(m_buffers[i]->drainedAndExited())
+			{
+				m_buffers[i]->reuse(thread);
+				return *m_buffers[i];
+			}
+		}
+
+		m_buffers.push_back(std::unique_ptr<TraceBuffer>(new TraceBuffer(thread)));
+		return *m_buffers.back();
+	}
+
+
+	//! Buffers made so far, in use or waiting to be reused.
+	std::size_t buffers()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_buffers.size();
+	}
+
+
+	//! A copy of name that lives as long as the tracer, for names that
+	//! aren't literals.
+	char const * intern(std::string const & name)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_names.insert(name).first->c_str();
+	}
+
+
+	//! Writes everything since the last flush as a Chrome trace.
+	void writeChromeTrace(std::ostream & out)
+	{
+		TickCalibration const & calibration = TickClock::calibration();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		writeChromeTrace(out, m_buffers.begin(), m_buffers.end(), calibration);
+	}
+
+
+	//! Writes only buffer's zones since it was last flushed, eg
+	//! writeChromeTrace(out, Tracer::threadBuffer()) for the calling thread.
+	void writeChromeTrace(std::ostream & out, TraceBuffer & buffer)
+	{
+		TickCalibration const & calibration = TickClock::calibration();
+		TraceBuffer * const buffers[] = { &buffer };
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		writeChromeTrace(out, buffers, buffers + 1, calibration);
+	}
+
+
+	//! Writes everything since the last flush to a Chrome trace file.
+	bool flush(char const * path)
+	{
+		std::ofstream file(path);
+
+		if(!file) {
+			return false;
+		}
+
+		writeChromeTrace(file);
+		return bool(file);
+	}
+
+}; // class Tracer
+
+
+/*!
+ *	Times its own lifetime into the calling thread's buffer.
+ */
+class TraceScope
+{
+	TraceBuffer 	&m_buffer;
+	char const 		*m_name;
+	std::uint64_t 	m_begin;
+
+public:
+
+	// The buffer is found (made on a thread's first zone) before the clock
+	// is read, so that cost isn't counted in the zone.
+	explicit TraceScope(char const * name)
+		: m_buffer(Tracer::threadBuffer())
+		, m_name(name)
+		, m_begin(TickClock::now())
+	{}
+
+	~TraceScope()
+	{
+		std::uint64_t const end = TickClock::now();
+		m_buffer.add(m_name, m_begin, end);
+	}
+
+	TraceScope(TraceScope const &) = delete;
+	TraceScope & operator=(TraceScope const &) = delete;
+
+}; // class TraceScope
+
+
+} // namespace Dead
+
+
+#endif // #ifndef DEAD_TRACE_TRACER_INCLUDED
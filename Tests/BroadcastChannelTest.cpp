@@ -0,0 +1,195 @@
+// BroadcastChannelTest.cpp
+
+#include <Dead/Test/UnitTest.hpp>
+#include <Dead/Test/Benchmark.hpp>
+#include <Dead/Events/BroadcastChannel.hpp>
+#include <Dead/Config/Threads.hpp>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+
+// TEST SETUP
+
+struct TickEvent
+{
+	std::uint64_t frame;
+};
+
+typedef Dead::BroadcastChannel<TickEvent> 		TickChannel;
+typedef Dead::BroadcastSubscriber<TickEvent> 	TickSubscriber;
+
+// Padded, not over aligned, so plain new works before C++17.
+static_assert(alignof(TickChannel) <= alignof(std::max_align_t), "BroadcastChannel shouldn't be over aligned.");
+static_assert(alignof(TickSubscriber) <= alignof(std::max_align_t), "BroadcastSubscriber shouldn't be over aligned.");
+
+
+// TESTS
+
+
+// Every subscriber sees every event, in order, from when it subscribed.
+TEST(SubscribersSeeEveryEvent)
+{
+	TickChannel ticks(16);
+	TickSubscriber first(ticks);
+
+	TickEvent const tick = { 1 };
+	ticks.publish(tick);
+
+	TickSubscriber late(ticks);
+
+	for(std::uint64_t frame = 2; frame <= 5; ++frame)
+	{
+		TickEvent const next = { frame };
+		ticks.publish(next);
+	}
+
+	std::uint64_t firstSum(0), lateSum(0);
+
+	ASSERT_IS_EQUAL(5u, first.poll([&](TickEvent const & event) { firstSum = firstSum * 10 + event.frame; }))
+	ASSERT_IS_EQUAL(4u, late.poll([&](TickEvent const & event) { lateSum = lateSum * 10 + event.frame; }))
+	ASSERT_IS_EQUAL(12345u, firstSum)
+	ASSERT_IS_EQUAL(2345u, lateSum)
+	ASSERT_IS_EQUAL(0u, first.pending())
+}
+
+
+
+// The publisher stops a ring ahead of the slowest subscriber.
+TEST(BackPressureFromSlowestCursor)
+{
+	TickChannel ticks(3);
+	ASSERT_IS_EQUAL(4u, ticks.capacity())
+
+	TickSubscriber fast(ticks), slow(ticks);
+	TickEvent const tick = { 7 };
+
+	for(int i = 0; i < 4; ++i) {
+		ASSERT_IS_TRUE(ticks.tryPublish(tick))
+	}
+
+	fast.poll([](TickEvent const &) {});
+	ASSERT_IS_FALSE(ticks.tryPublish(tick))
+
+	ASSERT_IS_EQUAL(2u, slow.poll([](TickEvent const &) {}, 2))
+	ASSERT_IS_EQUAL(2u, slow.pending())
+
+	ASSERT_IS_TRUE(ticks.tryPublish(tick))
+	ASSERT_IS_TRUE(ticks.tryPublish(tick))
+	ASSERT_IS_FALSE(ticks.tryPublish(tick))
+
+	// A subscriber that goes away stops holding the publisher up.
+	{
+		TickSubscriber gone(ticks);
+		ASSERT_IS_EQUAL(3u, ticks.subscribers())
+	}
+
+	ASSERT_IS_EQUAL(2u, ticks.subscribers())
+}
+
+
+
+#if defined(DEAD_HAS_THREADS)
+
+// Subscribers on their own threads, the publisher waits on them.
+TEST(ThreadedSubscribers)
+{
+	enum { EVENTS = 20000, SUBSCRIBERS = 3 };
+
+	TickChannel ticks(256);
+	std::vector<std::uint64_t> sums(SUBSCRIBERS, 0);
+	std::vector<int> ordered(SUBSCRIBERS, 1);
+
+	std::vector<TickSubscriber*> subscribers;
+
+	for(int i = 0; i < SUBSCRIBERS; ++i) {
+		subscribers.push_back(new TickSubscriber(ticks));
+	}
+
+	std::vector<std::thread> threads;
+
+	for(int i = 0; i < SUBSCRIBERS; ++i)
+	{
+		threads.push_back(std::thread([&, i]()
+		{
+			std::uint64_t seen(0);
+
+			while(seen < EVENTS)
+			{
+				std::size_t const count = subscribers[i]->poll([&](TickEvent const & event)
+				{
+					ordered[i] = ordered[i] && (event.frame == seen + 1);
+					sums[i] += event.frame;
+					++seen;
+				});
+
+				// Nothing yet, let the publisher run.
+				if(count == 0) {
+					std::this_thread::yield();
+				}
+			}
+		}));
+	}
+
+	for(std::uint64_t frame = 1; frame <= EVENTS; ++frame)
+	{
+		TickEvent const tick = { frame };
+		ticks.publish(tick);
+	}
+
+	for(int i = 0; i < SUBSCRIBERS; ++i)
+	{
+		threads[i].join();
+
+		ASSERT_IS_TRUE(ordered[i])
+		ASSERT_IS_EQUAL(std::uint64_t(EVENTS) * (EVENTS + 1) / 2, sums[i])
+
+		delete subscribers[i];
+	}
+}
+
+#endif
+
+
+
+// BENCHMARKS
+
+
+// One publish, read in batches by 64 subscribers.
+BENCHMARK(PublishToManySubscribers)
+{
+	TickChannel ticks(1024);
+	std::vector<TickSubscriber*> subscribers;
+
+	for(int i = 0; i < 64; ++i) {
+		subscribers.push_back(new TickSubscriber(ticks));
+	}
+
+	std::uint64_t frame(0), sum(0);
+
+	while(state.keepRunning())
+	{
+		TickEvent const tick = { ++frame };
+		ticks.publish(tick);
+
+		if((frame & 255) == 0)
+		{
+			for(std::size_t i = 0; i < subscribers.size(); ++i) {
+				subscribers[i]->poll([&](TickEvent const & event) { sum += event.frame; });
+			}
+		}
+	}
+
+	Dead::DoNotOptimize(sum);
+
+	for(std::size_t i = 0; i < subscribers.size(); ++i) {
+		delete subscribers[i];
+	}
+}
+
+
+
+int main(int argc, char **argv)
+{
+	return Dead::RunTests(argc, argv);
+}
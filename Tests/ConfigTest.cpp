@@ -0,0 +1,42 @@
+// ConfigTest.cpp
+
+#include <Dead/Test/UnitTest.hpp>
+#include <Dead/Config.hpp>
+#include <Dead/Log.hpp>
+
+
+// TESTS
+
+
+// We know what we're building on.
+TEST(PlatformDetected)
+{
+	#if defined(DEAD_ON_WINDOWS) || defined(DEAD_ON_POSIX)
+	ASSERT_IS_TRUE(true)
+	#else
+	ASSERT_IS_TRUE(false)
+	#endif
+
+	// Linux and Mac are POSIX too.
+	#if (defined(DEAD_ON_LINUX) || defined(DEAD_ON_MAC)) && !defined(DEAD_ON_POSIX)
+	ASSERT_IS_TRUE(false)
+	#endif
+
+	ASSERT_IS_TRUE((DEAD_CPP_VERSION >= 201103L))
+}
+
+
+
+// Cache lines are a power of two, and the aligned types use them.
+TEST(CacheLineSize)
+{
+	ASSERT_IS_EQUAL(0, (DEAD_CACHE_LINE_SIZE & (DEAD_CACHE_LINE_SIZE - 1)))
+	ASSERT_IS_EQUAL(DEAD_CACHE_LINE_SIZE, alignof(Dead::LogSite))
+}
+
+
+
+int main(int argc, char **argv)
+{
+	return Dead::RunTests(argc, argv);
+}
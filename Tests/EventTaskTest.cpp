@@ -0,0 +1,195 @@
+// EventTaskTest.cpp
+
+#define DEAD_TEST_ALLOCATION_HOOKS
+
+#include <Dead/Test/UnitTest.hpp>
+#include <Dead/Test/Benchmark.hpp>
+#include <Dead/Test/Performance.hpp>
+#include <Dead/Events/EventManager.hpp>
+
+#if defined(DEAD_HAS_COROUTINES)
+
+#include <Dead/Events/EventTask.hpp>
+
+
+// TEST SETUP
+
+enum ScriptEvents
+{
+	GAME_START_MSG,
+	PLAYER_DEAD_MSG,
+};
+
+struct ScriptEvent
+{
+	int player;
+};
+
+struct ScriptController
+{
+	int received = 0;
+
+	bool receiveEvent(int, ScriptEvent *)
+	{
+		++received;
+		return true;
+	}
+};
+
+typedef Dead::SimpleEventManager<ScriptController, int, ScriptEvent*, Dead::SimpleStackNoDelete<int, ScriptEvent*> > ScriptEventManager;
+
+
+// Waits for the start, then counts deaths of one player.
+Dead::EventTask countDeaths(ScriptEventManager & eventMgr, int player, int & started, int & deaths)
+{
+	co_await eventMgr.next(GAME_START_MSG);
+	++started;
+
+	for(;;)
+	{
+		ScriptEvent *event = co_await eventMgr.next(PLAYER_DEAD_MSG, [player](ScriptEvent * e) { return e->player == player; });
+
+		if(event->player == player) {
+			++deaths;
+		}
+	}
+}
+
+
+Dead::EventTask waitOnce(ScriptEventManager & eventMgr, ScriptEvent *& received)
+{
+	received = co_await eventMgr.next(GAME_START_MSG);
+}
+
+
+// TESTS
+
+
+// Resumes straight from fireInstantEvent, before the (swallowing) controllers.
+TEST(NextResumesOnInstantEvent)
+{
+	ScriptEventManager eventMgr;
+	ScriptController controller;
+	ScriptEvent event = { 1 };
+	ScriptEvent *received = 0;
+
+	eventMgr.addController(&controller, GAME_START_MSG);
+
+	Dead::EventTask task = waitOnce(eventMgr, received);
+	ASSERT_IS_FALSE(task.done())
+
+	eventMgr.fireInstantEvent(&event, PLAYER_DEAD_MSG);
+	ASSERT_IS_FALSE(task.done())
+
+	eventMgr.fireInstantEvent(&event, GAME_START_MSG);
+	ASSERT_IS_TRUE(task.done())
+	ASSERT_IS_EQUAL(&event, received)
+	ASSERT_IS_EQUAL(1, controller.received)
+}
+
+
+
+// The predicate picks which events resume, waiting again from inside a
+// resume doesn't see the same event twice.
+TEST(NextWithPredicate)
+{
+	ScriptEventManager eventMgr;
+	ScriptEvent players[] = { { 1 }, { 2 } };
+	int started(0), deaths(0);
+
+	Dead::EventTask task = countDeaths(eventMgr, 2, started, deaths);
+
+	eventMgr.addQueuedEvent(&players[1], PLAYER_DEAD_MSG);
+	eventMgr.addQueuedEvent(&players[0], GAME_START_MSG);
+	eventMgr.fireQueuedEvents();
+
+	// Stack order, so the start came first and the death after.
+	ASSERT_IS_EQUAL(1, started)
+	ASSERT_IS_EQUAL(1, deaths)
+
+	eventMgr.fireInstantEvent(&players[0], PLAYER_DEAD_MSG);
+	eventMgr.fireInstantEvent(&players[1], PLAYER_DEAD_MSG);
+	eventMgr.fireInstantEvent(&players[1], PLAYER_DEAD_MSG);
+
+	ASSERT_IS_EQUAL(3, deaths)
+	ASSERT_IS_FALSE(task.done())
+}
+
+
+
+// Cancelled scripts are taken off the manager, scripts can outlive it.
+TEST(CancelWaitingTask)
+{
+	ScriptEvent event = { 1 };
+	int started(0), deaths(0);
+
+	ScriptEventManager eventMgr;
+	Dead::EventTask first  = countDeaths(eventMgr, 1, started, deaths);
+	Dead::EventTask second = countDeaths(eventMgr, 1, started, deaths);
+	Dead::EventTask third  = countDeaths(eventMgr, 1, started, deaths);
+
+	second.cancel();
+	ASSERT_IS_TRUE(second.done())
+
+	eventMgr.fireInstantEvent(&event, GAME_START_MSG);
+	ASSERT_IS_EQUAL(2, started)
+
+	first = Dead::EventTask();
+	eventMgr.fireInstantEvent(&event, PLAYER_DEAD_MSG);
+	ASSERT_IS_EQUAL(1, deaths)
+
+	{
+		ScriptEventManager shortLived;
+		third = countDeaths(shortLived, 1, started, deaths);
+	}
+
+	ASSERT_IS_FALSE(third.done())
+}
+
+
+
+// Once a frame size has been seen, scripts start and wait without the heap.
+TEST(PooledFrames)
+{
+	ScriptEventManager eventMgr;
+	ScriptEvent event = { 1 };
+	ScriptEvent *received = 0;
+
+	waitOnce(eventMgr, received);
+
+	ASSERT_NO_ALLOCATIONS
+	{
+		Dead::EventTask task = waitOnce(eventMgr, received);
+		eventMgr.fireInstantEvent(&event, GAME_START_MSG);
+	}
+
+	ASSERT_IS_EQUAL(&event, received)
+}
+
+
+
+// BENCHMARKS
+
+
+BENCHMARK(ResumeWaiter)
+{
+	ScriptEventManager eventMgr;
+	ScriptEvent event = { 1 };
+	int started(0), deaths(0);
+
+	Dead::EventTask task = countDeaths(eventMgr, 1, started, deaths);
+	eventMgr.fireInstantEvent(&event, GAME_START_MSG);
+
+	while(state.keepRunning()) {
+		eventMgr.fireInstantEvent(&event, PLAYER_DEAD_MSG);
+	}
+}
+
+#endif // DEAD_HAS_COROUTINES
+
+
+
+int main(int argc, char **argv)
+{
+	return Dead::RunTests(argc, argv);
+}
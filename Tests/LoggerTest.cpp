@@ -0,0 +1,455 @@
+// LoggerTest.cpp
+
+#include <Dead/Test/UnitTest.hpp>
+#include <Dead/Test/Benchmark.hpp>
+#include <Dead/Log/RateLimit.hpp>
+#include <Dead/Log/FlightRecorder.hpp>
+#include <Dead/Log/RecordHeader.hpp>
+#include <Dead/Log/TeeOutput.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+
+// TEST SETUP
+
+// Keeps everything it's given, so the tests can see what a policy wrote.
+template<int Tag>
+struct CaptureOutput
+{
+	static std::string captured;
+
+	~CaptureOutput() {
+		captured += "\n";
+	}
+
+	template<typename T>
+	void out(T const & output)
+	{
+		std::ostringstream stream;
+		stream << output;
+		captured += stream.str();
+	}
+};
+
+template<int Tag>
+std::string CaptureOutput<Tag>::captured;
+
+
+// The flight recorder is a singleton, its tests take turns under --jobs.
+std::mutex g_flightRecorderMutex;
+
+// So do the tests reading FileOutput's file.
+std::mutex g_logFileMutex;
+
+
+// The end of FileOutput's file.
+std::string logFileTail(std::size_t size)
+{
+	std::ifstream file("LoggerOutput.txt");
+	std::string const contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	return contents.substr(contents.size() - std::min(contents.size(), size));
+}
+
+
+// Logs while a FileOutput record is being formatted.
+std::string logToFile()
+{
+	Dead::Logger<Dead::FileOutput>() << "inner";
+	return "outer";
+}
+
+
+
+// TESTS
+
+
+// Every n'th call gets through.
+TEST(LogEveryN)
+{
+	Dead::LogSite site;
+	unsigned int logged(0);
+
+	for(unsigned int i = 0; i < 9; ++i)
+	{
+		if(!site.everyN(3)) {
+			++logged;
+		}
+	}
+
+	ASSERT_IS_EQUAL(3, logged)
+	ASSERT_IS_EQUAL(9, site.calls())
+}
+
+
+
+// Only the first n calls get through.
+TEST(LogFirstN)
+{
+	Dead::LogSite site;
+	unsigned int logged(0);
+
+	for(unsigned int i = 0; i < 100; ++i)
+	{
+		if(!site.firstN(4)) {
+			++logged;
+		}
+	}
+
+	ASSERT_IS_EQUAL(4, logged)
+}
+
+
+
+// Only n calls get through inside a second.
+TEST(LogAtMostPerSecond)
+{
+	Dead::LogSite site;
+	unsigned int logged(0);
+
+	for(unsigned int i = 0; i < 1000; ++i)
+	{
+		if(!site.atMostPerSecond(5)) {
+			++logged;
+		}
+	}
+
+	ASSERT_IS_EQUAL(5, logged)
+}
+
+
+
+// A limit of 0 never logs.
+TEST(LogZeroLimitNever)
+{
+	Dead::LogSite everySite, perSecondSite;
+
+	for(unsigned int i = 0; i < 10; ++i)
+	{
+		ASSERT_IS_TRUE(bool(everySite.everyN(0)))
+		ASSERT_IS_TRUE(bool(perSecondSite.atMostPerSecond(0)))
+	}
+}
+
+
+
+// The summary only appears once something has been dropped.
+TEST(LogSuppressedSummary)
+{
+	Dead::LogSite site;
+
+	Dead::LogGate first = site.everyN(2);
+	site.everyN(2);
+	Dead::LogGate second = site.everyN(2);
+
+	std::ostringstream firstOut, secondOut;
+	firstOut << first;
+	secondOut << second;
+
+	ASSERT_IS_TRUE(firstOut.str().empty())
+	ASSERT_IS_EQUAL(std::string("[suppressed 1 messages] "), secondOut.str())
+}
+
+
+
+// Records come back out of the file in order, only the tail is kept.
+TEST(FlightRecorderTail)
+{
+	std::lock_guard<std::mutex> lock(g_flightRecorderMutex);
+
+	char const * path = "FlightRecorderTest.rec";
+
+	bool opened = Dead::FlightRecorder::instance().open(path, 8);
+	ASSERT_IS_TRUE(opened)
+
+	for(int i = 0; i < 20; ++i) {
+		Dead::Logger<Dead::FlightRecorderOutput>(Dead::LOG_WARNING) << "Record " << i;
+	}
+
+	Dead::FlightRecorder::instance().close();
+
+	Dead::FlightRecorderContents contents;
+	bool read = Dead::readFlightRecorder(path, contents);
+	std::remove(path);
+
+	std::vector<Dead::FlightRecord> const &records = contents.records;
+
+	ASSERT_IS_TRUE(read)
+	ASSERT_IS_EQUAL(8, records.size())
+	ASSERT_IS_EQUAL(12, records.front().sequence)
+	ASSERT_IS_EQUAL(std::string("Record 12"), records.front().text)
+	ASSERT_IS_EQUAL(std::string("Record 19"), records.back().text)
+	ASSERT_IS_EQUAL(Dead::LOG_WARNING, records.back().header.level)
+	ASSERT_IS_EQUAL(Dead::currentThreadId(), records.back().header.thread)
+}
+
+
+
+// A ring needs at least one slot.
+TEST(FlightRecorderNoSlots)
+{
+	std::lock_guard<std::mutex> lock(g_flightRecorderMutex);
+
+	ASSERT_IS_FALSE(Dead::FlightRecorder::instance().open("FlightRecorderEmpty.rec", 0))
+	ASSERT_IS_FALSE(Dead::FlightRecorder::instance().isOpen())
+
+	// Dropped, not a crash.
+	Dead::Logger<Dead::FlightRecorderOutput>() << "Nowhere to go";
+	std::remove("FlightRecorderEmpty.rec");
+}
+
+
+
+// Threads reserve blocks of sequences, every record still comes back and
+// each thread's are in order.
+TEST(FlightRecorderThreads)
+{
+	std::lock_guard<std::mutex> lock(g_flightRecorderMutex);
+
+	enum { THREADS = 4, RECORDS = 100 };
+	char const * path = "FlightRecorderThreads.rec";
+
+	ASSERT_IS_TRUE(Dead::FlightRecorder::instance().open(path, 1024))
+
+	std::vector<std::thread> threads;
+
+	for(int t = 0; t < THREADS; ++t)
+	{
+		threads.push_back(std::thread([]()
+		{
+			for(int i = 0; i < RECORDS; ++i) {
+				Dead::Logger<Dead::FlightRecorderOutput>() << i;
+			}
+		}));
+	}
+
+	for(int t = 0; t < THREADS; ++t) {
+		threads[t].join();
+	}
+
+	Dead::FlightRecorder::instance().close();
+
+	Dead::FlightRecorderContents contents;
+	bool read = Dead::readFlightRecorder(path, contents);
+	std::remove(path);
+
+	ASSERT_IS_TRUE(read)
+	ASSERT_IS_EQUAL(THREADS * RECORDS, contents.records.size())
+
+	std::map<std::uint32_t, int> next;
+	bool ordered(true);
+
+	for(std::size_t i = 0; i < contents.records.size(); ++i)
+	{
+		int &expected = next[contents.records[i].header.thread];
+		ordered = ordered && (contents.records[i].text == std::to_string(expected));
+		++expected;
+	}
+
+	ASSERT_IS_TRUE(ordered)
+	ASSERT_IS_EQUAL(THREADS, next.size())
+}
+
+
+
+// Blocks a thread didn't finish leave slots from an older lap behind, they
+// aren't part of the tail.
+TEST(FlightRecorderDropsOldLaps)
+{
+	std::lock_guard<std::mutex> lock(g_flightRecorderMutex);
+
+	enum { THREADS = 4, SLOTS = 1024, NEW_RECORDS = 8 };
+	char const * path = "FlightRecorderLaps.rec";
+
+	ASSERT_IS_TRUE(Dead::FlightRecorder::instance().open(path, SLOTS))
+
+	// Laps the ring a few times, then each new thread uses only part of
+	// its block.
+	for(int lap = 0; lap < 2; ++lap)
+	{
+		std::vector<std::thread> threads;
+
+		for(int t = 0; t < THREADS; ++t)
+		{
+			threads.push_back(std::thread([lap]()
+			{
+				for(int i = 0; i < (lap == 0 ? int(SLOTS) : int(NEW_RECORDS)); ++i) {
+					Dead::Logger<Dead::FlightRecorderOutput>() << (lap == 0 ? "old" : "new");
+				}
+			}));
+		}
+
+		for(int t = 0; t < THREADS; ++t) {
+			threads[t].join();
+		}
+	}
+
+	Dead::FlightRecorder::instance().close();
+
+	Dead::FlightRecorderContents contents;
+	bool read = Dead::readFlightRecorder(path, contents);
+	std::remove(path);
+
+	ASSERT_IS_TRUE(read)
+
+	std::vector<Dead::FlightRecord> const &records = contents.records;
+	std::uint64_t newest(0);
+	std::size_t newRecords(0);
+
+	for(std::size_t i = 0; i < records.size(); ++i)
+	{
+		newest = std::max(newest, records[i].sequence);
+		newRecords += (records[i].text == "new") ? 1 : 0;
+	}
+
+	bool inTail(true);
+
+	for(std::size_t i = 0; i < records.size(); ++i) {
+		inTail = inTail && (records[i].sequence + SLOTS > newest);
+	}
+
+	ASSERT_IS_TRUE(inTail)
+	ASSERT_IS_EQUAL(THREADS * NEW_RECORDS, newRecords)
+
+	// The new records come last.
+	ASSERT_IS_EQUAL("new", records.back().text)
+	ASSERT_IS_EQUAL("old", records[records.size() - THREADS * NEW_RECORDS - 1].text)
+}
+
+
+
+// Header is formatted from the ticks only when asked.
+TEST(RecordHeaderFormat)
+{
+	Dead::TickCalibration calibration = { 1000, 1500000000123456789LL, 1.0 };
+	Dead::RecordHeader header = { 1000 + 1000000000, 3, Dead::LOG_ERROR };
+
+	char buffer[64];
+	Dead::formatRecordHeader(buffer, sizeof(buffer), header, calibration);
+
+	ASSERT_IS_EQUAL(std::string("[2017-07-14 02:40:01.123456789] [T3] [ERROR] "), std::string(buffer))
+}
+
+
+
+// Ticks move forward and convert to roughly now.
+TEST(TickClockCalibration)
+{
+	std::uint64_t const first 	= Dead::TickClock::now();
+	std::uint64_t const second 	= Dead::TickClock::now();
+
+	ASSERT_IS_TRUE((second >= first))
+
+	std::int64_t const wallNs = Dead::TickClock::calibration().toWallNs(second);
+	std::int64_t const nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+
+	ASSERT_IS_LESS(std::abs(nowNs - wallNs), 50000000)
+}
+
+
+
+// Every sink gets the record, filtered sinks only get what passes.
+TEST(TeeOutputFanOut)
+{
+	typedef Dead::Logger<Dead::TeeOutput<CaptureOutput<0>,
+										 Dead::Filtered<CaptureOutput<1>, Dead::LOG_WARNING> > > TeeLog;
+
+	TeeLog(Dead::LOG_INFO) << "Info " << 1;
+	TeeLog(Dead::LOG_ERROR) << "Error " << 2.5;
+
+	ASSERT_IS_EQUAL(std::string("Info 1\nError 2.5\n"), CaptureOutput<0>::captured)
+	ASSERT_IS_EQUAL(std::string("Error 2.5\n"), CaptureOutput<1>::captured)
+}
+
+
+
+// A file sink keeps every record, not just the last.
+TEST(TeeOutputToFile)
+{
+	std::lock_guard<std::mutex> lock(g_logFileMutex);
+
+	typedef Dead::Logger<Dead::TeeOutput<CaptureOutput<2>, Dead::FileOutput> > TeeLog;
+
+	TeeLog() << "one";
+	TeeLog() << "two";
+	TeeLog() << "three";
+
+	std::string const expected("one\ntwo\nthree\n");
+
+	ASSERT_IS_EQUAL(expected, CaptureOutput<2>::captured)
+	ASSERT_IS_EQUAL(expected, logFileTail(expected.size()))
+}
+
+
+
+// A file record can log to the file while it's being formatted.
+TEST(FileOutputNested)
+{
+	std::lock_guard<std::mutex> lock(g_logFileMutex);
+
+	Dead::Logger<Dead::FileOutput>() << logToFile();
+	Dead::Logger<Dead::TeeOutput<Dead::FileOutput> >() << logToFile();
+
+	std::string const expected("inner\nouter\ninner\nouter\n");
+	ASSERT_IS_EQUAL(expected, logFileTail(expected.size()))
+}
+
+
+
+// A record too long for the tee's buffer is cut short and says so.
+TEST(TeeOutputTruncates)
+{
+	typedef Dead::Logger<Dead::TeeOutput<CaptureOutput<3> > > TeeLog;
+
+	std::string const record(2000, 'x');
+	TeeLog() << record;
+
+	std::string const &captured = CaptureOutput<3>::captured;
+
+	ASSERT_IS_EQUAL(std::size_t(1024 + 1), captured.size())
+	ASSERT_IS_EQUAL(std::string(1021, 'x') + "...\n", captured)
+}
+
+
+
+// BENCHMARKS
+
+
+// What a suppressed call costs.
+BENCHMARK(LogSiteSuppressed)
+{
+	Dead::LogSite site;
+	site.firstN(0);
+
+	while(state.keepRunning()) {
+		Dead::DoNotOptimize(site.firstN(0));
+	}
+}
+
+
+
+// Formatting a record into the stack buffer.
+BENCHMARK(RecordBufferFormat)
+{
+	while(state.keepRunning())
+	{
+		Dead::RecordBuffer<256> record;
+		record << "Frame " << 42 << " hp " << 0.75;
+		Dead::DoNotOptimize(record.size());
+	}
+}
+
+
+
+int main(int argc, char **argv)
+{
+	return Dead::RunTests(argc, argv);
+}
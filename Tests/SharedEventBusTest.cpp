@@ -0,0 +1,252 @@
+// SharedEventBusTest.cpp
+
+#include <Dead/Test/UnitTest.hpp>
+#include <Dead/Test/Benchmark.hpp>
+#include <Dead/Events/EventManager.hpp>
+#include <Dead/Events/SharedEventBus.hpp>
+#include <sstream>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+// TEST SETUP
+
+enum BusEvents
+{
+	ENTITY_MOVED_MSG,
+	ENTITY_DIED_MSG,
+};
+
+struct MovedEvent
+{
+	std::uint32_t 	entity;
+	float 			position[3];
+};
+
+typedef Dead::SharedEventBus<BusEvents, MovedEvent> MovedBus;
+
+
+struct BusController
+{
+	std::uint32_t 	lastEntity;
+	int 			received;
+
+	BusController()
+		: lastEntity(0)
+		, received(0)
+	{}
+
+	bool receiveEvent(BusEvents, MovedEvent * event)
+	{
+		lastEntity = event->entity;
+		++received;
+		return false;
+	}
+};
+
+typedef Dead::SimpleEventManager<BusController, BusEvents, MovedEvent*, Dead::SimpleStackNoDelete<BusEvents, MovedEvent*> > BusEventManager;
+
+
+// Unique per process and test, so test shards running at the same time
+// don't unlink each other's bus.
+std::string busName(char const * test)
+{
+	std::ostringstream name;
+	name << "/dead-shared-event-bus-test-" << getpid() << "-" << test;
+
+	return name.str();
+}
+
+
+// Overwrites the slot count in a bus's header, like a corrupt or foreign
+// one would have.
+void setSlotCount(char const * name, std::uint32_t slotCount)
+{
+	int const file = shm_open(name, O_RDWR, 0600);
+	void *memory = mmap(0, sizeof(Dead::SharedEventBusHeader), PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	close(file);
+
+	static_cast<Dead::SharedEventBusHeader*>(memory)->slotCount = slotCount;
+	munmap(memory, sizeof(Dead::SharedEventBusHeader));
+}
+
+
+MovedEvent moved(std::uint32_t entity)
+{
+	MovedEvent event = { entity, { float(entity), 0.0f, 0.0f } };
+	return event;
+}
+
+
+// TESTS
+
+
+// A second mapping sees what the first publishes, in order.
+TEST(PublishAndPoll)
+{
+	std::string const name = busName("PublishAndPoll");
+	MovedBus publisher, reader;
+
+	ASSERT_IS_TRUE(publisher.create(name.c_str(), 16))
+	ASSERT_IS_TRUE(reader.attach(name.c_str()))
+	ASSERT_IS_EQUAL(16u, reader.slotCount())
+
+	Dead::SharedEventCursor cursor = reader.subscribe();
+
+	publisher.publish(ENTITY_MOVED_MSG, moved(1));
+	publisher.publish(ENTITY_DIED_MSG, moved(2));
+
+	std::uint32_t sum(0);
+	BusEvents lastId(ENTITY_MOVED_MSG);
+
+	std::size_t const count = reader.poll(cursor, [&](BusEvents id, MovedEvent const & event) {
+		sum = sum * 10 + event.entity;
+		lastId = id;
+	});
+
+	ASSERT_IS_EQUAL(2u, count)
+	ASSERT_IS_EQUAL(12u, sum)
+	ASSERT_IS_EQUAL(ENTITY_DIED_MSG, lastId)
+	ASSERT_IS_EQUAL(0u, reader.poll(cursor, [](BusEvents, MovedEvent const &) {}))
+
+	MovedBus::remove(name.c_str());
+}
+
+
+
+// Attaching checks the bus is there and holds the same types.
+TEST(AttachChecksLayout)
+{
+	std::string const name = busName("AttachChecksLayout");
+	MovedBus bus;
+
+	MovedBus::remove(name.c_str());
+	ASSERT_IS_FALSE(bus.attach(name.c_str()))
+	ASSERT_IS_FALSE(bus.create(name.c_str(), 12))
+
+	ASSERT_IS_TRUE(bus.create(name.c_str(), 8))
+
+	Dead::SharedEventBus<BusEvents, double> other;
+	ASSERT_IS_FALSE(other.attach(name.c_str()))
+
+	// Slot counts create() wouldn't take.
+	MovedBus reader;
+
+	setSlotCount(name.c_str(), 0);
+	ASSERT_IS_FALSE(reader.attach(name.c_str()))
+
+	setSlotCount(name.c_str(), 3);
+	ASSERT_IS_FALSE(reader.attach(name.c_str()))
+
+	setSlotCount(name.c_str(), 8);
+	ASSERT_IS_TRUE(reader.attach(name.c_str()))
+
+	MovedBus::remove(name.c_str());
+}
+
+
+
+// A reader that falls a whole ring behind skips and counts the loss.
+TEST(SlowReaderIsLapped)
+{
+	std::string const name = busName("SlowReaderIsLapped");
+	MovedBus bus;
+	bus.create(name.c_str(), 8);
+
+	Dead::SharedEventCursor cursor = bus.subscribe();
+
+	for(std::uint32_t i = 0; i < 20; ++i) {
+		bus.publish(ENTITY_MOVED_MSG, moved(i));
+	}
+
+	std::uint32_t first(0);
+	std::size_t const count = bus.poll(cursor, [&](BusEvents, MovedEvent const & event) {
+		first = first ? first : event.entity;
+	});
+
+	ASSERT_IS_EQUAL(8u, count)
+	ASSERT_IS_EQUAL(12u, cursor.lost)
+	ASSERT_IS_EQUAL(12u, first)
+
+	MovedBus::remove(name.c_str());
+}
+
+
+
+// Events from another process come out of forward() as instant events.
+TEST(ForwardFromAnotherProcess)
+{
+	std::string const name = busName("ForwardFromAnotherProcess");
+	MovedBus bus;
+	bus.create(name.c_str(), 1024);
+
+	Dead::SharedEventCursor cursor = bus.subscribe();
+
+	pid_t const child = fork();
+
+	if(child == 0)
+	{
+		MovedBus publisher;
+
+		if(!publisher.attach(name.c_str())) {
+			_exit(1);
+		}
+
+		for(std::uint32_t i = 1; i <= 500; ++i) {
+			publisher.publish(ENTITY_MOVED_MSG, moved(i));
+		}
+
+		_exit(0);
+	}
+
+	int status(1);
+	waitpid(child, &status, 0);
+	ASSERT_IS_EQUAL(0, status)
+
+	BusController controller;
+	BusEventManager eventMgr;
+	eventMgr.addController(&controller, ENTITY_MOVED_MSG);
+
+	ASSERT_IS_EQUAL(100u, bus.forward(cursor, eventMgr, 100))
+	ASSERT_IS_EQUAL(400u, bus.forward(cursor, eventMgr))
+	ASSERT_IS_EQUAL(500, controller.received)
+	ASSERT_IS_EQUAL(500u, controller.lastEntity)
+	ASSERT_IS_EQUAL(0u, cursor.lost)
+
+	MovedBus::remove(name.c_str());
+}
+
+
+
+// BENCHMARKS
+
+
+BENCHMARK(PublishAndPollEvent)
+{
+	std::string const name = busName("PublishAndPollEvent");
+	MovedBus bus;
+	bus.create(name.c_str(), 1024);
+
+	Dead::SharedEventCursor cursor = bus.subscribe();
+	MovedEvent const event = moved(1);
+	std::uint32_t sum(0);
+
+	while(state.keepRunning())
+	{
+		bus.publish(ENTITY_MOVED_MSG, event);
+		bus.poll(cursor, [&](BusEvents, MovedEvent const & e) { sum += e.entity; });
+	}
+
+	Dead::DoNotOptimize(sum);
+	MovedBus::remove(name.c_str());
+}
+
+
+
+int main(int argc, char **argv)
+{
+	return Dead::RunTests(argc, argv);
+}
@@ -1,8 +1,13 @@
 // UtilitiesTest.cpp
 
+#define DEAD_TEST_ALLOCATION_HOOKS
+
 #include <Dead/Test/UnitTest.hpp>
+#include <Dead/Test/Benchmark.hpp>
+#include <Dead/Test/Performance.hpp>
 #include <Dead/Events/EventManager.hpp>
 #include <boost/shared_ptr.hpp>
+#include <deque>
 #include <iostream>
 
 // TEST SETUP
@@ -102,6 +107,44 @@ struct GameEndEventData : public IEvent {
 
 
 
+// A queue policy that doesn't store owners, first in first out.
+struct FifoQueue
+{
+	struct QueuedEvent { Events id; EventType event; };
+
+	std::deque<QueuedEvent> m_queue;
+
+	void addToQueue(EventType data, Events const &id)
+	{
+		QueuedEvent event = { id, data };
+		m_queue.push_back(event);
+	}
+
+	EventType getNextEvent() { return m_queue.front().event; }
+	Events getNextEventID() { return m_queue.front().id; }
+
+	bool popEvent()
+	{
+		if(m_queue.empty()) {
+			return false;
+		}
+
+		m_queue.pop_front();
+		return true;
+	}
+
+	std::size_t size()  const { return m_queue.size();  }
+	bool 		empty() const { return m_queue.empty(); }
+};
+
+typedef Dead::SimpleEventManager<Controller, Events, EventType, FifoQueue> FifoEventManager;
+
+static_assert(Dead::Details::QueueHasOwners<Dead::SimpleStackNoDelete<Events, EventType> >::value, "SimpleStack stores owners.");
+static_assert(!Dead::Details::QueueHasOwners<FifoQueue>::value, "FifoQueue doesn't store owners.");
+
+
+
+
 // Globals for Testing //
 
 EventManager 	g_eventManger;
@@ -203,9 +246,161 @@ TEST(RemoveListner)
 
 
 
-int main()
+// Firing queued events on a warmed up manager shouldn't touch the heap.
+TEST(FireQueuedEventsNoAllocations)
 {
-	Dead::RunTests();
+	EventManager manager;
+	Controller controller;
+	manager.addController(&controller, g_events[GAME_END_MSG]);
 
-	return 0;
+	GameEndEventDataPtr data(new GameEndEventData());
+
+	for(int i = 0; i < 8; ++i) {
+		manager.addQueuedEvent(data, g_events[GAME_END_MSG]);
+	}
+
+	ASSERT_NO_ALLOCATIONS {
+		manager.fireQueuedEvents();
+	}
+
+	ASSERT_IS_EQUAL(0, manager.sizeOfQueue())
+	ASSERT_FASTER_THAN(1000, 10000, manager.fireInstantEvent(data, g_events[GAME_END_MSG]))
+}
+
+
+
+// Destroying an owner drops its queued events, everyone else's still go.
+TEST(DestroyedOwnerEventsSkipped)
+{
+	EventManager manager;
+	Controller controller;
+	manager.addController(&controller, g_events[GAME_END_MSG]);
+
+	Dead::EventOwner const despawned = manager.createOwner();
+	Dead::EventOwner const alive 	 = manager.createOwner();
+
+	GameEndEventDataPtr data(new GameEndEventData());
+
+	manager.addQueuedEvent(data, g_events[GAME_END_MSG], despawned);
+	manager.addQueuedEvent(data, g_events[GAME_END_MSG], despawned);
+
+	ASSERT_IS_TRUE(manager.destroyOwner(despawned))
+	ASSERT_IS_FALSE(manager.destroyOwner(despawned))
+	ASSERT_IS_FALSE(manager.isOwnerAlive(despawned))
+
+	manager.fireQueuedEvents();
+
+	ASSERT_IS_FALSE(controller.hasReceivedEvent())
+	ASSERT_IS_EQUAL(0, manager.sizeOfQueue())
+
+	// The index gets reused, the old handle stays stale.
+	Dead::EventOwner const respawned = manager.createOwner();
+
+	ASSERT_IS_EQUAL(despawned.index, respawned.index)
+	ASSERT_IS_TRUE((despawned != respawned))
+
+	manager.addQueuedEvent(data, g_events[GAME_END_MSG], despawned);
+	manager.fireQueuedEvents();
+	ASSERT_IS_FALSE(controller.hasReceivedEvent())
+
+	manager.addQueuedEvent(data, g_events[GAME_END_MSG], alive);
+	manager.fireQueuedEvents();
+	ASSERT_IS_TRUE(controller.hasReceivedEvent())
+}
+
+
+
+// A queue policy without owners still works, everything queued is sent.
+TEST(QueueWithoutOwners)
+{
+	FifoEventManager manager;
+	Controller controller;
+	manager.addController(&controller, g_events[GAME_END_MSG]);
+
+	manager.addQueuedEvent(GameEndEventDataPtr(new GameEndEventData()), g_events[GAME_END_MSG]);
+	ASSERT_IS_EQUAL(1, manager.sizeOfQueue())
+
+	manager.fireQueuedEvents();
+
+	ASSERT_IS_TRUE(controller.hasReceivedEvent())
+	ASSERT_IS_EQUAL(0, manager.sizeOfQueue())
+}
+
+
+
+// BENCHMARKS
+
+
+// Instant event to one controller.
+BENCHMARK(FireInstantEvent)
+{
+	EventManager manager;
+	Controller controller;
+	manager.addController(&controller, g_events[GAME_START_MSG]);
+
+	GameStartEventDataPtr data(new GameStartEventData());
+
+	while(state.keepRunning()) {
+		manager.fireInstantEvent(data, g_events[GAME_START_MSG]);
+	}
+}
+
+
+
+// Queue and fire a batch of events.
+BENCHMARK(QueueAndFireEvents)
+{
+	EventManager manager;
+	Controller controller;
+	manager.addController(&controller, g_events[GAME_END_MSG]);
+
+	GameEndEventDataPtr data(new GameEndEventData());
+
+	while(state.keepRunning())
+	{
+		for(int i = 0; i < 16; ++i) {
+			manager.addQueuedEvent(data, g_events[GAME_END_MSG]);
+		}
+
+		manager.fireQueuedEvents();
+	}
+}
+
+
+
+// Half the owners of a batch despawn before it is fired.
+BENCHMARK(FireEventsAfterMassDespawn)
+{
+	EventManager manager;
+	Controller controller;
+	manager.addController(&controller, g_events[GAME_END_MSG]);
+
+	GameEndEventDataPtr data(new GameEndEventData());
+	Dead::EventOwner owners[16];
+
+	while(state.keepRunning())
+	{
+		for(int i = 0; i < 16; ++i)
+		{
+			owners[i] = manager.createOwner();
+			manager.addQueuedEvent(data, g_events[GAME_END_MSG], owners[i]);
+		}
+
+		for(int i = 0; i < 16; i += 2) {
+			manager.destroyOwner(owners[i]);
+		}
+
+		manager.fireQueuedEvents();
+
+		for(int i = 1; i < 16; i += 2) {
+			manager.destroyOwner(owners[i]);
+		}
+	}
+}
+
+
+
+int main(int argc, char **argv)
+{
+	return Dead::RunTests(argc, argv);
 }
\ No newline at end of file
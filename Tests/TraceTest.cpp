@@ -0,0 +1,188 @@
+// TraceTest.cpp
+
+#define DEAD_TRACE_ENABLED
+
+#include <Dead/Test/UnitTest.hpp>
+#include <Dead/Test/Benchmark.hpp>
+#include <Dead/Events/EventManager.hpp>
+#include <Dead/Trace.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+
+
+// TEST SETUP
+
+struct TraceEvent {};
+
+struct TraceController
+{
+	bool receiveEvent(int, TraceEvent *) { return false; }
+};
+
+typedef Dead::SimpleEventManager<TraceController, int, TraceEvent*, Dead::SimpleStackNoDelete<int, TraceEvent*> > TraceEventManager;
+
+
+// Everything traced on this thread since its last flush. Only ever drains
+// the calling thread's buffer, so tests running in parallel don't take
+// each other's zones.
+std::string flushTrace()
+{
+	std::ostringstream out;
+	Dead::Tracer::instance().writeChromeTrace(out, Dead::Tracer::threadBuffer());
+
+	return out.str();
+}
+
+
+// A test to run from inside TestZones.
+struct NestedTest : public Dead::ITest
+{
+	std::string getName() const { return "NestedTest"; }
+
+	void run() const {
+		DEAD_TRACE_SCOPE("NestedTestBody");
+	}
+};
+
+
+// TESTS
+
+
+// Zones come out as complete events, once.
+TEST(ZonesExportAsChromeTrace)
+{
+	flushTrace();
+
+	{
+		DEAD_TRACE_SCOPE("Outer");
+		DEAD_TRACE_SCOPE_STRING(std::string("Inner ") + "\"quoted\"");
+	}
+
+	std::string const trace = flushTrace();
+
+	ASSERT_IS_TRUE((trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[") == 0))
+	ASSERT_IS_TRUE((trace.find("\"name\":\"Outer\",\"ph\":\"X\"") != std::string::npos))
+	ASSERT_IS_TRUE((trace.find("\"name\":\"Inner \\\"quoted\\\"\"") != std::string::npos))
+
+	// The inner zone ends first so is written first.
+	ASSERT_IS_TRUE((trace.find("Inner") < trace.find("Outer")))
+
+	ASSERT_IS_TRUE((flushTrace().find("Outer") == std::string::npos))
+}
+
+
+
+// Zones from a thread that has finished are still flushed.
+TEST(ThreadZones)
+{
+	Dead::TraceBuffer *buffer = 0;
+
+	std::thread thread([&buffer]()
+	{
+		DEAD_TRACE_SCOPE("Worker");
+		buffer = &Dead::Tracer::threadBuffer();
+	});
+	thread.join();
+
+	std::ostringstream out;
+	Dead::Tracer::instance().writeChromeTrace(out, *buffer);
+
+	ASSERT_IS_TRUE((out.str().find("\"name\":\"Worker\"") != std::string::npos))
+}
+
+
+
+// A buffer goes to a new thread once its thread has exited and it has been
+// flushed, not before.
+TEST(BuffersAreReused)
+{
+	Dead::Tracer tracer;
+	std::ostringstream out;
+
+	Dead::TraceBuffer &first = tracer.addBuffer(1);
+	first.add("First", 1, 2);
+	first.threadExited();
+
+	Dead::TraceBuffer &second = tracer.addBuffer(2);
+	ASSERT_IS_TRUE((&second != &first))
+
+	tracer.writeChromeTrace(out);
+	ASSERT_IS_TRUE((out.str().find("\"name\":\"First\",\"ph\":\"X\",\"pid\":1,\"tid\":1,") != std::string::npos))
+
+	Dead::TraceBuffer &third = tracer.addBuffer(3);
+	ASSERT_IS_TRUE((&third == &first))
+	ASSERT_IS_EQUAL(tracer.buffers(), 2u)
+
+	// Reused empty, with the new thread's id.
+	third.add("Third", 3, 4);
+	out.str("");
+	tracer.writeChromeTrace(out, third);
+
+	ASSERT_IS_TRUE((out.str().find("First") == std::string::npos))
+	ASSERT_IS_TRUE((out.str().find("\"name\":\"Third\",\"ph\":\"X\",\"pid\":1,\"tid\":3,") != std::string::npos))
+}
+
+
+
+// The event manager traces the queue and each controller.
+TEST(EventManagerZones)
+{
+	TraceController controllers[2];
+	TraceEvent event;
+
+	TraceEventManager eventMgr;
+	eventMgr.addController(&controllers[0], 1);
+	eventMgr.addController(&controllers[1], 1);
+
+	flushTrace();
+
+	eventMgr.addQueuedEvent(&event, 1);
+	eventMgr.fireQueuedEvents();
+
+	std::string const trace = flushTrace();
+	std::size_t const receive = trace.find("\"name\":\"receiveEvent\"");
+
+	ASSERT_IS_TRUE((trace.find("\"name\":\"fireQueuedEvents\"") != std::string::npos))
+	ASSERT_IS_TRUE((receive != std::string::npos))
+	ASSERT_IS_TRUE((trace.find("\"name\":\"receiveEvent\"", receive + 1) != std::string::npos))
+}
+
+
+
+// Each test run gets a zone around its own.
+TEST(TestZones)
+{
+	NestedTest const test;
+	Dead::TestResult result;
+
+	flushTrace();
+	Dead::UnitTest::runTest(test, result);
+
+	std::string const trace = flushTrace();
+	std::size_t const body = trace.find("\"name\":\"NestedTestBody\"");
+
+	ASSERT_IS_TRUE((body != std::string::npos))
+	ASSERT_IS_TRUE((trace.find("\"name\":\"NestedTest\"", body) != std::string::npos))
+}
+
+
+
+// BENCHMARKS
+
+
+BENCHMARK(TraceScope)
+{
+	while(state.keepRunning()) {
+		DEAD_TRACE_SCOPE("Benchmark");
+	}
+
+	flushTrace();
+}
+
+
+
+int main(int argc, char **argv)
+{
+	return Dead::RunTests(argc, argv);
+}
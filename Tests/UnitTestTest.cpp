@@ -0,0 +1,230 @@
+// UnitTestTest.cpp
+
+#define DEAD_TEST_ALLOCATION_HOOKS
+
+#include <Dead/Test/UnitTest.hpp>
+#include <Dead/Test/Benchmark.hpp>
+#include <Dead/Test/Performance.hpp>
+#include <Dead/Test/PerfCounters.hpp>
+#include <thread>
+#include <vector>
+
+#if defined(DEAD_ON_POSIX)
+#include <cstdio>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+
+// TEST SETUP
+
+// Read from memory, so ASSERT_FASTER_THAN can't fold sumTo() away.
+unsigned int g_sumCount = 100000;
+
+// No side effects, the compiler is free to drop a call whose result is
+// thrown away.
+inline unsigned int sumTo(unsigned int count)
+{
+	unsigned int sum(0);
+
+	for(unsigned int i = 0; i < count; ++i) {
+		sum += i * i ^ sum;
+	}
+
+	return sum;
+}
+
+
+// Runs an ASSERT_FASTER_THAN that has to fail, so TimedTooSlow can check
+// it did without failing the run.
+struct SlowTest : public Dead::ITest
+{
+	std::string getName() const { return "SlowTest"; }
+
+	void run() const {
+		ASSERT_FASTER_THAN(10, 100, sumTo(g_sumCount))
+	}
+};
+
+
+// TESTS
+
+
+// Wildcards in test filters.
+TEST(FilterWildcards)
+{
+	ASSERT_IS_TRUE(Dead::Details::matchesFilter("", "AnyTest"))
+	ASSERT_IS_TRUE(Dead::Details::matchesFilter("AnyTest", "AnyTest"))
+	ASSERT_IS_TRUE(Dead::Details::matchesFilter("Any*", "AnyTest"))
+	ASSERT_IS_TRUE(Dead::Details::matchesFilter("?nyTes?", "AnyTest"))
+	ASSERT_IS_FALSE(Dead::Details::matchesFilter("Any", "AnyTest"))
+	ASSERT_IS_FALSE(Dead::Details::matchesFilter("Other*", "AnyTest"))
+}
+
+
+
+// Lists of includes and excludes.
+TEST(FilterIncludeExclude)
+{
+	ASSERT_IS_TRUE(Dead::Details::matchesFilter("Other,Any*", "AnyTest"))
+	ASSERT_IS_TRUE(Dead::Details::matchesFilter("-Other*", "AnyTest"))
+	ASSERT_IS_FALSE(Dead::Details::matchesFilter("-Any*", "AnyTest"))
+	ASSERT_IS_FALSE(Dead::Details::matchesFilter("*Test,-Any*", "AnyTest"))
+}
+
+
+
+// Command line options.
+TEST(ParseTestOptions)
+{
+	char program[] = "Tests", jobs[] = "--jobs=4", filter[] = "--filter=Log*", shard[] = "--shard=2/3";
+	char *argv[] = { program, jobs, filter, shard };
+
+	Dead::TestOptions options;
+	bool parsed = Dead::parseTestOptions(4, argv, options);
+
+	ASSERT_IS_TRUE(parsed)
+	ASSERT_IS_EQUAL(4, options.jobs)
+	ASSERT_IS_EQUAL(std::string("Log*"), options.filter)
+	ASSERT_IS_EQUAL(2, options.shardIndex)
+	ASSERT_IS_EQUAL(3, options.shardCount)
+}
+
+
+
+// The benchmark loop runs exactly as many times as asked.
+TEST(BenchmarkStateIterations)
+{
+	Dead::BenchmarkState state(10);
+	unsigned int count(0);
+
+	while(state.keepRunning()) {
+		++count;
+	}
+
+	ASSERT_IS_EQUAL(10, count)
+	ASSERT_IS_FALSE(state.keepRunning())
+	ASSERT_IS_TRUE((state.elapsedNs() >= 0.0))
+}
+
+
+
+// Allocations on this thread are counted from when the scope starts.
+TEST(AllocationScopeCounts)
+{
+	Dead::AllocationScope scope;
+
+	std::vector<int> *numbers = new std::vector<int>(16);
+	Dead::DoNotOptimize(numbers);
+	delete numbers;
+
+	ASSERT_IS_EQUAL(2, scope.allocations())
+	ASSERT_IS_EQUAL(sizeof(std::vector<int>) + 16 * sizeof(int), scope.bytes())
+
+	ASSERT_MAX_ALLOCATIONS(2) {
+		std::vector<int> other(4);
+	}
+
+	ASSERT_NO_ALLOCATIONS {
+		int onTheStack[16] = { 0 };
+		Dead::DoNotOptimize(onTheStack);
+	}
+}
+
+
+
+// A side effect free expression is still timed, and too slow fails.
+TEST(TimedTooSlow)
+{
+	SlowTest const test;
+	Dead::TestResult result;
+
+	Dead::UnitTest::runTest(test, result);
+
+	ASSERT_IS_EQUAL(0u, result.passed)
+	ASSERT_IS_EQUAL(1u, result.failed)
+	ASSERT_IS_TRUE((result.output.str().find("Failed! ASSERT_FASTER_THAN, sumTo(g_sumCount) took") != std::string::npos))
+
+	ASSERT_FASTER_THAN(1000000000, 1, g_sumCount = 1)
+	ASSERT_IS_EQUAL(1u, g_sumCount)
+}
+
+
+
+// Counters either count or say why they can't.
+TEST(PerfCountersFallback)
+{
+	Dead::PerfCounters counters;
+
+	counters.start();
+	counters.stop();
+
+	if(counters.available()) {
+		ASSERT_IS_TRUE(counters.total().has(Dead::PerfCounterValues::CYCLES))
+	} else {
+		ASSERT_IS_FALSE(counters.unavailableReason().empty())
+		ASSERT_IS_FALSE(counters.total().has(Dead::PerfCounterValues::CYCLES))
+	}
+
+	Dead::PerfCounterValues values;
+	values.values[Dead::PerfCounterValues::CYCLES] 		 = 200.0;
+	values.values[Dead::PerfCounterValues::INSTRUCTIONS] = 600.0;
+
+	Dead::PerfCounterValues const perIteration = values.dividedBy(100.0);
+
+	ASSERT_IS_NEAR(2.0, perIteration.cycles(), 0.0001)
+	ASSERT_IS_NEAR(3.0, perIteration.ipc(), 0.0001)
+	ASSERT_IS_FALSE(perIteration.has(Dead::PerfCounterValues::CACHE_MISSES))
+}
+
+
+
+// Asserts on a thread the test spawned aren't lost.
+TEST(HelperThreadAssertsCount)
+{
+	unsigned int const passed = Dead::UnitTest::instance().loosePassed();
+
+	std::thread helper([]() { ASSERT_IS_TRUE(true) });
+	helper.join();
+
+	ASSERT_IS_TRUE((Dead::UnitTest::instance().loosePassed() >= passed + 1))
+}
+
+
+
+#if defined(DEAD_ON_POSIX)
+// A failed assert on a helper thread fails the run, checked in a child
+// process so this run isn't failed by it.
+TEST(HelperThreadFailureFailsRun)
+{
+	// Or the child writes out what's still buffered a second time.
+	std::cout.flush();
+	std::fflush(stdout);
+
+	pid_t const child = fork();
+
+	if(child == 0)
+	{
+		std::freopen("/dev/null", "w", stdout);
+
+		std::thread helper([]() { ASSERT_IS_TRUE(false) });
+		helper.join();
+
+		Dead::TestOptions options;
+		options.filter = "-*";
+
+		_exit(Dead::UnitTest::instance().runTests(options) == 1 ? 0 : 1);
+	}
+
+	int status(-1);
+	waitpid(child, &status, 0);
+
+	ASSERT_IS_TRUE((WIFEXITED(status) && WEXITSTATUS(status) == 0))
+}
+#endif
+
+
+int main(int argc, char **argv)
+{
+	return Dead::RunTests(argc, argv);
+}
@@ -0,0 +1,37 @@
+// FlightRecorderDump.cpp
+// Prints the tail of a flight recorder file, oldest record first.
+//
+// Usage: FlightRecorderDump <file>
+
+#include <Dead/Log/FlightRecorder.hpp>
+#include <iostream>
+
+
+int main(int argc, char **argv)
+{
+	if(argc != 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <file>" << std::endl;
+		return 1;
+	}
+
+	Dead::FlightRecorderContents contents;
+
+	if(!Dead::readFlightRecorder(argv[1], contents))
+	{
+		std::cerr << "Couldn't read flight recorder file " << argv[1] << std::endl;
+		return 1;
+	}
+
+	std::vector<Dead::FlightRecord>::const_iterator recordIt = contents.records.begin();
+
+	for(; recordIt != contents.records.end(); ++recordIt)
+	{
+		char header[64];
+		Dead::formatRecordHeader(header, sizeof(header), recordIt->header, contents.calibration);
+
+		std::cout << "#" << recordIt->sequence << " " << header << recordIt->text << "\n";
+	}
+
+	return 0;
+}